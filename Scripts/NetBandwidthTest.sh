@@ -0,0 +1,94 @@
+#!/usr/bin/env bash
+# Starts a StrikesServer and N headless clients on this machine, lets them play for a while and summarises the
+# per-client bandwidth the server logged.
+#
+# Usage: Scripts/NetBandwidthTest.sh <ServerBinary> <ClientBinary> [Clients=8] [Seconds=60] [Map=FirstPersonMap]
+#
+# The binaries are the packaged or staged StrikesServer and Strikes executables. Logs and the summary are written to
+# Saved/NetBandwidthTest/<date>/: Server.log, Client<i>.log and Summary.csv.
+
+set -euo pipefail
+
+if [[ $# -lt 2 ]]; then
+	sed -n '2,8p' "$0"
+	exit 1
+fi
+
+SERVER_BINARY=$1
+CLIENT_BINARY=$2
+NUM_CLIENTS=${3:-8}
+SECONDS_TO_RUN=${4:-60}
+MAP=${5:-FirstPersonMap}
+LOG_INTERVAL=5
+
+OUT_DIR="$(cd "$(dirname "$0")/.." && pwd)/Saved/NetBandwidthTest/$(date +%Y.%m.%d-%H.%M.%S)"
+mkdir -p "$OUT_DIR"
+
+PIDS=()
+cleanup()
+{
+	for PID in "${PIDS[@]}"; do
+		kill "$PID" 2>/dev/null || true
+	done
+	wait 2>/dev/null || true
+}
+trap cleanup EXIT
+
+"$SERVER_BINARY" "$MAP" -log -unattended -abslog="$OUT_DIR/Server.log" \
+	-ini:Engine:[ConsoleVariables]:Strikes.Net.BandwidthLogInterval=$LOG_INTERVAL >/dev/null 2>&1 &
+PIDS+=($!)
+
+# Give the server time to load the map before the clients connect
+sleep 10
+
+for ((i = 0; i < NUM_CLIENTS; ++i)); do
+	"$CLIENT_BINARY" 127.0.0.1 -nullrhi -nosound -unattended -windowed -abslog="$OUT_DIR/Client$i.log" >/dev/null 2>&1 &
+	PIDS+=($!)
+done
+
+echo "Running $NUM_CLIENTS clients for $SECONDS_TO_RUN s, logs in $OUT_DIR"
+sleep "$SECONDS_TO_RUN"
+cleanup
+trap - EXIT
+
+# Server lines: "Net: <player> out <n> B/s in <n> B/s" per client and "Net: replicate <n> ms/frame, ..." per interval.
+# The first sample of each is skipped, since clients are still joining
+awk -v Clients="$NUM_CLIENTS" '
+	/Net: replicate / {
+		match($0, /replicate [0-9.]+/)
+		Replicate = substr($0, RSTART + 10, RLENGTH - 10)
+		if (++Intervals > 1) { ReplicateSum += Replicate; ++ReplicateCount }
+		next
+	}
+	/Net: .* out [0-9]+ B\/s in [0-9]+ B\/s/ {
+		match($0, /Net: [^ ]+ out [0-9]+ B\/s in [0-9]+ B\/s/)
+		split(substr($0, RSTART, RLENGTH), Fields, " ")
+		Player = Fields[2]
+		if (++Seen[Player] < 2) next
+		Out[Player] += Fields[4]
+		In[Player] += Fields[7]
+		++Samples[Player]
+	}
+	END {
+		print "Player,Samples,AvgOutBytesPerSecond,AvgInBytesPerSecond"
+		for (Player in Samples)
+		{
+			printf "%s,%d,%.0f,%.0f\n", Player, Samples[Player], Out[Player] / Samples[Player], In[Player] / Samples[Player]
+			TotalOut += Out[Player] / Samples[Player]
+			TotalIn += In[Player] / Samples[Player]
+			++Players
+		}
+		if (Players > 0)
+		{
+			printf "AllClients,%d,%.0f,%.0f\n", Players, TotalOut / Players, TotalIn / Players
+		}
+		if (ReplicateCount > 0)
+		{
+			printf "ReplicateMsPerFrame,%d,%.3f,\n", ReplicateCount, ReplicateSum / ReplicateCount
+		}
+		if (Players < Clients)
+		{
+			printf "Only %d of %d clients were logged; see the client logs\n", Players, Clients > "/dev/stderr"
+		}
+	}
+' "$OUT_DIR/Server.log" | tee "$OUT_DIR/Summary.csv"
@@ -11,5 +11,8 @@ public class StrikesTarget : TargetRules
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_4;
 		ExtraModuleNames.Add("Strikes");
+
+		// Health and magic replicate with the push model
+		bWithPushModel = true;
 	}
 }
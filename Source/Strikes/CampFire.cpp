@@ -3,7 +3,10 @@
 
 #include "CampFire.h"
 #include  "Kismet/GameplayStatics.h"
-#include  "TimerManager.h"
+#include "StrikesDamageZones.h"
+#include "StrikesLevelReset.h"
+#include "StrikesCharacter.h"
+#include "StrikesStats.h"
 
 // Sets default values
 ACampFire::ACampFire()
@@ -24,8 +27,91 @@ ACampFire::ACampFire()
 	MyBoxComponent->OnComponentBeginOverlap.AddDynamic(this, &ACampFire::OnOverlapBegin);
 	MyBoxComponent->OnComponentEndOverlap.AddDynamic(this, &ACampFire::OnOverlapEnd);
 
-	// Initialize the flag for applying damage
-	bCanApplyDamage = false;
+	// Damage every actor in the fire by 200 every 2.2 seconds
+	// 2.2f - so we don't conflict with the invincibility where 2.f
+	DamageAmount = 200.f;
+	DamageInterval = 2.2f;
+
+	bUseTriggerGrid = false;
+	bSendDamageEvents = false;
+
+	// Placed in the level and never changes, so clients only need the initial state
+	bReplicates = true;
+	NetDormancy = DORM_Initial;
+}
+
+void ACampFire::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UStrikesLevelResetSubsystem* ResetSubsystem = GetWorld()->GetSubsystem<UStrikesLevelResetSubsystem>())
+	{
+		ResetSubsystem->Register(this);
+	}
+
+	if (bUseTriggerGrid)
+	{
+		// The grid reports characters entering and leaving, physics no longer needs to
+		MyBoxComponent->SetGenerateOverlapEvents(false);
+		RegisterGridTrigger();
+	}
+}
+
+void ACampFire::RegisterGridTrigger()
+{
+	if (UStrikesTriggerGridSubsystem* TriggerGrid = GetWorld()->GetSubsystem<UStrikesTriggerGridSubsystem>())
+	{
+		TriggerGrid->RegisterBox(this, MyBoxComponent->Bounds.GetBox());
+	}
+}
+
+void ACampFire::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UStrikesDamageZoneSubsystem* DamageZones = GetWorld()->GetSubsystem<UStrikesDamageZoneSubsystem>())
+	{
+		DamageZones->RemoveZone(this);
+	}
+
+	if (UStrikesTriggerGridSubsystem* TriggerGrid = GetWorld()->GetSubsystem<UStrikesTriggerGridSubsystem>())
+	{
+		TriggerGrid->Unregister(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ACampFire::RestoreInitialState()
+{
+	UStrikesDamageZoneSubsystem* DamageZones = GetWorld()->GetSubsystem<UStrikesDamageZoneSubsystem>();
+	if (DamageZones == nullptr)
+	{
+		return;
+	}
+
+	// Start over with whatever overlaps the fire right now; later moves are reported through overlap events
+	DamageZones->RemoveZone(this);
+
+	if (bUseTriggerGrid)
+	{
+		// Registering again forgets the previous overlaps, so characters inside are reported on the next grid tick
+		if (UStrikesTriggerGridSubsystem* TriggerGrid = GetWorld()->GetSubsystem<UStrikesTriggerGridSubsystem>())
+		{
+			TriggerGrid->Unregister(this);
+		}
+		RegisterGridTrigger();
+		return;
+	}
+
+	TArray<UPrimitiveComponent*> OverlappingComponents;
+	MyBoxComponent->GetOverlappingComponents(OverlappingComponents);
+	for (UPrimitiveComponent* OtherComp : OverlappingComponents)
+	{
+		AActor* OtherActor = OtherComp->GetOwner();
+		if ((OtherActor != nullptr) && (OtherActor != this))
+		{
+			DamageZones->AddVictim(this, OtherActor, FHitResult());
+		}
+	}
 }
 
 void ACampFire::OnOverlapBegin(
@@ -37,24 +123,14 @@ void ACampFire::OnOverlapBegin(
 	const FHitResult& SweepResult
 )
 {
-	// Check if the overlapped actor is valid and not the current instance
-	if ((OtherActor != nullptr) && (OtherActor != this) && (OtherComp != nullptr))
+	// Check if the overlapped actor is valid and not the current instance; only the server applies damage
+	if ((OtherActor != nullptr) && (OtherActor != this) && (OtherComp != nullptr) && HasAuthority())
 	{
-		// Enable damage application and store the actor and hit result
-		bCanApplyDamage = true;
-		MyCharacter = Cast<AActor>(OtherActor);
-		MyHit = SweepResult;
-
-		// Set a timer to repeatedly apply damage to the overlapping actor
-		// 2.2f - so we don't conflict with the invincibility where 2.f 
-		GetWorldTimerManager().SetTimer(
-			FireTimerHandle,
-			this,
-			&ACampFire::ApplyFireDamage,
-			2.2f,
-			true,
-			0.f
-		);
+		// Start applying damage to the actor, together with every other actor in every other fire
+		if (UStrikesDamageZoneSubsystem* DamageZones = GetWorld()->GetSubsystem<UStrikesDamageZoneSubsystem>())
+		{
+			DamageZones->AddVictim(this, OtherActor, SweepResult);
+		}
 	}
 }
 
@@ -65,24 +141,52 @@ void ACampFire::OnOverlapEnd(
 	int32 OtherBodyIndex
 )
 {
-	// Disable damage application and clear the damage timer
-	bCanApplyDamage = false;
-	GetWorldTimerManager().ClearTimer(FireTimerHandle);
+	// Stop applying damage to the actor that left; others inside keep burning
+	if ((OtherActor != nullptr) && (OtherActor != this) && (OtherComp != nullptr) && HasAuthority())
+	{
+		if (UStrikesDamageZoneSubsystem* DamageZones = GetWorld()->GetSubsystem<UStrikesDamageZoneSubsystem>())
+		{
+			DamageZones->RemoveVictim(this, OtherActor);
+		}
+	}
+}
+
+void ACampFire::OnGridTriggerBegin(AStrikesCharacter* Character)
+{
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	if (UStrikesDamageZoneSubsystem* DamageZones = GetWorld()->GetSubsystem<UStrikesDamageZoneSubsystem>())
+	{
+		DamageZones->AddVictim(this, Character, FHitResult());
+	}
+}
+
+void ACampFire::OnGridTriggerEnd(AStrikesCharacter* Character)
+{
+	if (UStrikesDamageZoneSubsystem* DamageZones = GetWorld()->GetSubsystem<UStrikesDamageZoneSubsystem>())
+	{
+		DamageZones->RemoveVictim(this, Character);
+	}
 }
 
-void ACampFire::ApplyFireDamage()
+void ACampFire::ApplyFireDamage(AActor* Victim, const FHitResult& Hit)
 {
-	// Apply fire damage to the character if damage can be applied
-	if (bCanApplyDamage)
+	STRIKES_SCOPE_CYCLE_COUNTER(STAT_StrikesCampFireDamage);
+
+	// Apply fire damage to the actor inside the fire, as UGameplayStatics::ApplyPointDamage does
+	if (DamageAmount != 0.f)
 	{
-		UGameplayStatics::ApplyPointDamage(
-			MyCharacter,
-			200.0f,
-			GetActorLocation(),
-			MyHit,
-			nullptr,
-			this,
-			FireDamageType
-		);
+		Victim->TakeDamage(DamageAmount, MakeFireDamageEvent(Hit), nullptr, this);
 	}
 }
+
+FPointDamageEvent ACampFire::MakeFireDamageEvent(const FHitResult& Hit) const
+{
+	const TSubclassOf<UDamageType> DamageType = FireDamageType
+		? FireDamageType
+		: TSubclassOf<UDamageType>(UDamageType::StaticClass());
+	return FPointDamageEvent(DamageAmount, Hit, GetActorLocation(), DamageType);
+}
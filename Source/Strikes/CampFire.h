@@ -6,10 +6,13 @@
 #include "GameFramework/Actor.h"
 #include "Particles/ParticleSystemComponent.h"
 #include "Components/BoxComponent.h"
+#include "Engine/DamageEvents.h"
+#include "StrikesResettable.h"
+#include "StrikesTriggerGrid.h"
 #include "CampFire.generated.h"
 
 UCLASS()
-class STRIKES_API ACampFire : public AActor
+class STRIKES_API ACampFire : public AActor, public IStrikesResettable, public IStrikesGridTrigger
 {
 	GENERATED_BODY()
 
@@ -30,19 +33,22 @@ public:
 	UPROPERTY(EditAnywhere)
 	TSubclassOf<UDamageType> FireDamageType;
 
-	// Actor currently interacting with the campfire
+	// Damage applied to each actor inside the fire per damage tick
 	UPROPERTY(EditAnywhere)
-	AActor* MyCharacter;
+	float DamageAmount;
 
-	// Information about the hit result from the overlap
+	// Seconds between damage ticks for an actor standing in the fire
 	UPROPERTY(EditAnywhere)
-	FHitResult MyHit;
+	float DamageInterval;
 
-	// Flag indicating whether the campfire can apply damage
-	bool bCanApplyDamage;
+	// Detect actors through the trigger grid instead of physics overlap events; only characters are detected
+	UPROPERTY(EditAnywhere)
+	bool bUseTriggerGrid;
 
-	// Timer handle for managing the periodic application of damage
-	FTimerHandle FireTimerHandle;
+	// Damage characters one at a time through their TakeDamage instead of the attribute store's batch pass; the
+	// batch pass sends the same damage events afterwards, and other actors always go through TakeDamage
+	UPROPERTY(EditAnywhere)
+	bool bSendDamageEvents;
 
 	// Handles the beginning of an overlap event
 	UFUNCTION()
@@ -65,7 +71,30 @@ public:
 	);
 
 
-	// Applies fire damage to the actor
+	// Applies fire damage to an actor inside the fire; called by the damage zone subsystem
 	UFUNCTION()
-	void ApplyFireDamage();
+	void ApplyFireDamage(AActor* Victim, const FHitResult& Hit);
+
+	// Damage event for one damage tick, with the fire's damage type
+	FPointDamageEvent MakeFireDamageEvent(const FHitResult& Hit) const;
+
+	// Restarts damage for the actors currently inside the fire
+	virtual void RestoreInitialState() override;
+
+	// Starts damaging a character that walked into the fire
+	virtual void OnGridTriggerBegin(AStrikesCharacter* Character) override;
+
+	// Stops damaging a character that left the fire
+	virtual void OnGridTriggerEnd(AStrikesCharacter* Character) override;
+
+protected:
+	// Registers the campfire for soft level resets
+	virtual void BeginPlay() override;
+
+	// Stops damaging the actors inside the fire
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	// Adds the fire's box to the trigger grid
+	void RegisterGridTrigger();
 };
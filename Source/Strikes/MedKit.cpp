@@ -2,24 +2,101 @@
 
 
 #include "MedKit.h"
+#include "StrikesCoreHealth.h"
+#include "StrikesLevelReset.h"
+#include "StrikesStats.h"
 
 // Sets default values
 AMedKit::AMedKit()
 {
 	// Bind the overlap event to the OnOverlap function
 	OnActorBeginOverlap.AddDynamic(this, &AMedKit::OnOverlap);
+
+	// Replicate so clients see the medkit disappear when it is picked up; dormant until then
+	bReplicates = true;
+	NetDormancy = DORM_Initial;
+
+	bUseTriggerGrid = false;
+}
+
+void AMedKit::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UStrikesLevelResetSubsystem* ResetSubsystem = GetWorld()->GetSubsystem<UStrikesLevelResetSubsystem>())
+	{
+		ResetSubsystem->Register(this);
+	}
+
+	if (bUseTriggerGrid)
+	{
+		// The grid reports characters walking in, physics no longer needs to
+		TArray<UPrimitiveComponent*> Primitives;
+		GetComponents(Primitives);
+		for (UPrimitiveComponent* Primitive : Primitives)
+		{
+			Primitive->SetGenerateOverlapEvents(false);
+		}
+
+		if (UStrikesTriggerGridSubsystem* TriggerGrid = GetWorld()->GetSubsystem<UStrikesTriggerGridSubsystem>())
+		{
+			TriggerGrid->RegisterBox(this, GetComponentsBoundingBox(true));
+		}
+	}
+}
+
+void AMedKit::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UStrikesTriggerGridSubsystem* TriggerGrid = GetWorld()->GetSubsystem<UStrikesTriggerGridSubsystem>())
+	{
+		TriggerGrid->Unregister(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AMedKit::OnGridTriggerBegin(AStrikesCharacter* Character)
+{
+	OnOverlap(this, Character);
+}
+
+void AMedKit::RestoreInitialState()
+{
+	if (bConsumed)
+	{
+		// Bring the medkit back
+		bConsumed = false;
+		FlushNetDormancy();
+		SetActorHiddenInGame(false);
+		SetActorEnableCollision(true);
+
+		if (UStrikesTriggerGridSubsystem* TriggerGrid = GetWorld()->GetSubsystem<UStrikesTriggerGridSubsystem>())
+		{
+			TriggerGrid->SetTriggerEnabled(this, true);
+		}
+	}
+
+	MyCharacter = nullptr;
 }
 
 void AMedKit::OnOverlap(AActor* MyOverlappedActor, AActor* OtherActor)
 {
+	STRIKES_SCOPE_CYCLE_COUNTER(STAT_StrikesMedKitOverlap);
+
+	// Only the server heals
+	if (!HasAuthority())
+	{
+		return;
+	}
+
 	// Check if the overlapped actor is valid and not the current instance
 	if ((OtherActor != nullptr) && (OtherActor != this))
 	{
 		// Check if the overlapped actor is valid and not the current instance
 		MyCharacter = Cast<AStrikesCharacter>(OtherActor);
 
-		// If the character is valid and health is less than 1, heal the character
-		if (MyCharacter && MyCharacter->GetHealth() < 1.f)
+		// If the character is valid and not at full health, heal the character
+		if (MyCharacter && StrikesHealth::CanBeHealed(MyCharacter->GetHealthCoreState()))
 		{
 			GEngine->AddOnScreenDebugMessage(
 				-1,
@@ -28,9 +105,29 @@ void AMedKit::OnOverlap(AActor* MyOverlappedActor, AActor* OtherActor)
 				FString::Printf(TEXT("Add Health"))
 			);
 
-			// Increase the character's health and destroy the medkit
-			MyCharacter->UpdateHealth(100.f);
-			Destroy();
+			// Increase the character's health
+			MyCharacter->UpdateHealth(StrikesHealth::MedKitHeal);
+			INC_DWORD_STAT(STAT_StrikesPickups);
+
+			const UStrikesLevelResetSubsystem* ResetSubsystem = GetWorld()->GetSubsystem<UStrikesLevelResetSubsystem>();
+			if (ResetSubsystem && ResetSubsystem->bSoftReset)
+			{
+				// Keep the medkit around, hidden, so a soft reset can bring it back
+				bConsumed = true;
+				FlushNetDormancy();
+				SetActorHiddenInGame(true);
+				SetActorEnableCollision(false);
+
+				if (UStrikesTriggerGridSubsystem* TriggerGrid = GetWorld()->GetSubsystem<UStrikesTriggerGridSubsystem>())
+				{
+					TriggerGrid->SetTriggerEnabled(this, false);
+				}
+			}
+			else
+			{
+				// Destroy the medkit
+				Destroy();
+			}
 		}
 	}
 }
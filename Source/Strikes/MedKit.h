@@ -4,11 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "StrikesCharacter.h"
+#include "StrikesResettable.h"
+#include "StrikesTriggerGrid.h"
 #include "GameFramework/Actor.h"
 #include "MedKit.generated.h"
 
 UCLASS()
-class STRIKES_API AMedKit : public AActor
+class STRIKES_API AMedKit : public AActor, public IStrikesResettable, public IStrikesGridTrigger
 {
 	GENERATED_BODY()
 
@@ -22,4 +24,25 @@ public:
 
 	UPROPERTY(EditAnywhere)
 	AStrikesCharacter* MyCharacter;
+
+	// Detect characters through the trigger grid instead of physics overlap events
+	UPROPERTY(EditAnywhere)
+	bool bUseTriggerGrid;
+
+	// Heals a character that walked into the medkit
+	virtual void OnGridTriggerBegin(AStrikesCharacter* Character) override;
+
+	// Restores the medkit if it was picked up
+	virtual void RestoreInitialState() override;
+
+protected:
+	// Registers the medkit for soft level resets
+	virtual void BeginPlay() override;
+
+	// Removes the medkit from the trigger grid
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	// Set when the medkit was picked up but kept around for a soft reset
+	bool bConsumed = false;
 };
@@ -10,7 +10,8 @@ public class Strikes : ModuleRules
 
 		PublicDependencyModuleNames.AddRange(new string[]
 		{
-			"Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "UMG", "Slate", "SlateCore"
+			"Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "UMG", "Slate", "SlateCore",
+			"NetCore", "ReplicationGraph", "AIModule", "StrikesCore"
 		});
 	}
 }
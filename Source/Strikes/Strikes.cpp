@@ -1,7 +1,90 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Strikes.h"
+#include "StrikesStats.h"
+#include "Containers/Ticker.h"
 #include "Modules/ModuleManager.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, Strikes, "Strikes" );
+DEFINE_STAT(STAT_StrikesTimerOps);
+DEFINE_STAT(STAT_StrikesTimerOpsAvoided);
+DEFINE_STAT(STAT_StrikesTimerOpsPerSecond);
+DEFINE_STAT(STAT_StrikesTimerOpsAvoidedPerSecond);
+DEFINE_STAT(STAT_StrikesHitscanTraces);
+DEFINE_STAT(STAT_StrikesHUDPaint);
+DEFINE_STAT(STAT_StrikesHUDPrepass);
+DEFINE_STAT(STAT_StrikesWeaponFire);
+DEFINE_STAT(STAT_StrikesProjectileHit);
+DEFINE_STAT(STAT_StrikesCampFireDamage);
+DEFINE_STAT(STAT_StrikesTakeDamage);
+DEFINE_STAT(STAT_StrikesUpdateHealth);
+DEFINE_STAT(STAT_StrikesSetMagicValue);
+DEFINE_STAT(STAT_StrikesMedKitOverlap);
+DEFINE_STAT(STAT_StrikesHUDCreate);
+DEFINE_STAT(STAT_StrikesSoftReset);
+DEFINE_STAT(STAT_StrikesLastSoftResetMs);
+DEFINE_STAT(STAT_StrikesLastLevelReloadMs);
+DEFINE_STAT(STAT_StrikesAttributeSettle);
+DEFINE_STAT(STAT_StrikesShots);
+DEFINE_STAT(STAT_StrikesHits);
+DEFINE_STAT(STAT_StrikesDamageEvents);
+DEFINE_STAT(STAT_StrikesPickups);
+DEFINE_STAT(STAT_StrikesLiveProjectiles);
+DEFINE_STAT(STAT_StrikesLiveBatchedProjectiles);
+
+UE_TRACE_CHANNEL_DEFINE(StrikesChannel);
+
+CSV_DEFINE_CATEGORY_MODULE(STRIKES_API, Strikes, true);
+
+int64 StrikesFrameEvents::Totals[static_cast<int32>(EStrikesFrameEvent::ENum)] = {};
+
+#if STATS
+namespace
+{
+	/** Timer operation totals at the last rate update */
+	int64 LastTimerOps = 0;
+	int64 LastTimerOpsAvoided = 0;
+
+	/** Publishes the timer operations of the last second as `stat Strikes` rates */
+	bool UpdateTimerOpRates(const float DeltaTime)
+	{
+		const int64 TimerOps = StrikesFrameEvents::Totals[static_cast<int32>(EStrikesFrameEvent::ETimerOp)];
+		const int64 TimerOpsAvoided = StrikesFrameEvents::Totals[static_cast<int32>(EStrikesFrameEvent::ETimerOpAvoided)];
+		const float Seconds = FMath::Max(DeltaTime, UE_KINDA_SMALL_NUMBER);
+
+		SET_DWORD_STAT(STAT_StrikesTimerOpsPerSecond, FMath::RoundToInt32((TimerOps - LastTimerOps) / Seconds));
+		SET_DWORD_STAT(STAT_StrikesTimerOpsAvoidedPerSecond,
+		               FMath::RoundToInt32((TimerOpsAvoided - LastTimerOpsAvoided) / Seconds));
+
+		LastTimerOps = TimerOps;
+		LastTimerOpsAvoided = TimerOpsAvoided;
+		return true;
+	}
+}
+#endif
+
+/** Game module; updates the per-second Strikes stats */
+class FStrikesModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+#if STATS
+		RateTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&UpdateTimerOpRates), 1.f);
+#endif
+	}
+
+	virtual void ShutdownModule() override
+	{
+#if STATS
+		FTSTicker::GetCoreTicker().RemoveTicker(RateTickerHandle);
+#endif
+	}
+
+private:
+#if STATS
+	FTSTicker::FDelegateHandle RateTickerHandle;
+#endif
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FStrikesModule, Strikes, "Strikes" );
  
\ No newline at end of file
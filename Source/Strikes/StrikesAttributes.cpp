@@ -0,0 +1,73 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrikesAttributes.h"
+#include "StrikesCharacter.h"
+#include "StrikesStats.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+
+bool UStrikesAttributeSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// Characters in other worlds keep default attributes
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UStrikesAttributeSubsystem::IsTickable() const
+{
+	return Store.Num() > 0;
+}
+
+TStatId UStrikesAttributeSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UStrikesAttributeSubsystem, STATGROUP_Tickables);
+}
+
+FStrikesAttributeHandle UStrikesAttributeSubsystem::Register(AStrikesCharacter* Character,
+                                                             const FStrikesMagicRules& Rules)
+{
+	FStrikesMagicState Magic;
+	StrikesMagic::Reset(Magic, Rules);
+
+	const FStrikesAttributeHandle Handle = Store.Add(FStrikesHealthState(), Magic, Rules);
+	if (!Owners.IsValidIndex(Handle.Slot))
+	{
+		Owners.SetNum(Handle.Slot + 1);
+	}
+	Owners[Handle.Slot] = Character;
+
+	return Handle;
+}
+
+void UStrikesAttributeSubsystem::Unregister(const FStrikesAttributeHandle Handle)
+{
+	if (Store.GetIndex(Handle) == INDEX_NONE)
+	{
+		return;
+	}
+
+	Store.Remove(Handle);
+	Owners[Handle.Slot].Reset();
+}
+
+void UStrikesAttributeSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	STRIKES_SCOPE_CYCLE_COUNTER(STAT_StrikesAttributeSettle);
+
+	// Attribute timestamps are in server time, as AStrikesCharacter::GetServerTime reads them
+	const UWorld* World = GetWorld();
+	const AGameStateBase* GameState = World->GetGameState();
+	const double Now = GameState != nullptr ? GameState->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
+
+	Changed.Reset();
+	Store.SettleMagic(Now, Changed);
+
+	for (const int32 Index : Changed)
+	{
+		if (AStrikesCharacter* Character = Owners[Store.GetHandle(Index).Slot].Get())
+		{
+			Character->OnMagicSettled();
+		}
+	}
+}
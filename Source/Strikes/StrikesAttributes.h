@@ -0,0 +1,64 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StrikesCoreAttributes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "StrikesAttributes.generated.h"
+
+class AStrikesCharacter;
+
+/**
+ * Owns the health and magic of every character in the world, stored contiguously per field in an
+ * FStrikesAttributeStore; characters only keep a handle. Rules that come due over time, like the start of magic
+ * regeneration and the end of the magic curve, are applied for every character in one loop per frame.
+ */
+UCLASS()
+class STRIKES_API UStrikesAttributeSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Adds a character with full health and magic.
+	 *
+	 * @param Character The character, notified when its attributes change in the per-frame loop.
+	 * @param Rules Magic tuning of the character.
+	 * @return Handle the character reads and writes its attributes with.
+	 */
+	FStrikesAttributeHandle Register(AStrikesCharacter* Character, const FStrikesMagicRules& Rules);
+
+	/**
+	 * Removes a character's attributes.
+	 *
+	 * @param Handle Handle returned by Register; removed handles are ignored.
+	 */
+	void Unregister(FStrikesAttributeHandle Handle);
+
+	FStrikesAttributeStore& GetStore() { return Store; }
+	const FStrikesAttributeStore& GetStore() const { return Store; }
+
+	/** Number of characters with attributes */
+	UFUNCTION(BlueprintPure, Category="Attributes")
+	int32 GetNumCombatants() const { return Store.Num(); }
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	// End of FTickableGameObject interface
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Health and magic of every registered character */
+	FStrikesAttributeStore Store;
+
+	/** Character of each store slot */
+	TArray<TWeakObjectPtr<AStrikesCharacter>> Owners;
+
+	/** Indices changed by the last per-frame loop */
+	TArray<int32> Changed;
+};
@@ -0,0 +1,502 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrikesBenchmark.h"
+#include "CampFire.h"
+#include "MedKit.h"
+#include "StrikesCharacter.h"
+#include "StrikesPerfRun.h"
+#include "StrikesProjectile.h"
+#include "Components/SphereComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectArray.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogStrikesBenchmark, Log, All);
+
+const TCHAR* UStrikesBenchmarkSubsystem::GetScenarioName(const EStrikesBenchmarkScenario Scenario)
+{
+	switch (Scenario)
+	{
+	case EStrikesBenchmarkScenario::ECampFires:
+		return TEXT("CampFires");
+	case EStrikesBenchmarkScenario::EProjectiles:
+		return TEXT("Projectiles");
+	case EStrikesBenchmarkScenario::EMedKitStorm:
+		return TEXT("MedKitStorm");
+	}
+	return TEXT("Unknown");
+}
+
+TArray<EStrikesBenchmarkScenario> UStrikesBenchmarkSubsystem::GetAllScenarios()
+{
+	return {EStrikesBenchmarkScenario::ECampFires, EStrikesBenchmarkScenario::EProjectiles,
+	        EStrikesBenchmarkScenario::EMedKitStorm};
+}
+
+bool UStrikesBenchmarkSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// Only game worlds run benchmarks
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UStrikesBenchmarkSubsystem::IsTickable() const
+{
+	return Queue.Num() > 0;
+}
+
+TStatId UStrikesBenchmarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UStrikesBenchmarkSubsystem, STATGROUP_Tickables);
+}
+
+void UStrikesBenchmarkSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Scenarios spawn gameplay actors, which only the server or a standalone game can do
+	if (!FParse::Param(FCommandLine::Get(), TEXT("StrikesBenchmark")) || InWorld.GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	FString Names;
+	FParse::Value(FCommandLine::Get(), TEXT("StrikesBenchmark="), Names, false);
+
+	TArray<FString> Selected;
+	Names.ParseIntoArray(Selected, TEXT(","));
+
+	TArray<EStrikesBenchmarkScenario> Scenarios;
+	for (const EStrikesBenchmarkScenario Scenario : GetAllScenarios())
+	{
+		if (Selected.Num() == 0 || Selected.Contains(GetScenarioName(Scenario)))
+		{
+			Scenarios.Add(Scenario);
+		}
+	}
+
+	if (Scenarios.Num() == 0)
+	{
+		UE_LOG(LogStrikesBenchmark, Error, TEXT("No benchmark scenario matches '%s'"), *Names);
+		return;
+	}
+
+	Run(Scenarios, bExitWhenDone);
+}
+
+void UStrikesBenchmarkSubsystem::Run(const TArray<EStrikesBenchmarkScenario>& Scenarios, const bool bInQuitWhenDone)
+{
+	if (IsRunning() || Scenarios.Num() == 0)
+	{
+		return;
+	}
+
+	Queue = Scenarios;
+	Results.Reset();
+	bQuitWhenDone = bInQuitWhenDone;
+	bRecordBaselines = FParse::Param(FCommandLine::Get(), TEXT("StrikesBenchmarkRecord"));
+
+	SetUpScenario();
+}
+
+void UStrikesBenchmarkSubsystem::SetUpScenario()
+{
+	Current = FStrikesBenchmarkResult();
+	Current.Scenario = Queue[0];
+	Frame = 0;
+	GameThreadMs.Reset(MeasureFrames);
+
+	MemoryBefore = FPlatformMemory::GetStats().UsedPhysical;
+	ObjectsBefore = GUObjectArray.GetObjectArrayNumMinusAvailable();
+
+	switch (Current.Scenario)
+	{
+	case EStrikesBenchmarkScenario::ECampFires:
+		SetUpCampFires();
+		break;
+	case EStrikesBenchmarkScenario::EProjectiles:
+		SetUpProjectiles();
+		break;
+	case EStrikesBenchmarkScenario::EMedKitStorm:
+		SetUpMedKitStorm();
+		break;
+	}
+
+	UE_LOG(LogStrikesBenchmark, Display, TEXT("Benchmark %s: %d actors spawned"),
+	       GetScenarioName(Current.Scenario), SpawnedActors.Num() + MedKits.Num());
+}
+
+void UStrikesBenchmarkSubsystem::SetUpCampFires()
+{
+	UWorld* World = GetWorld();
+
+	// Fires in a row, 400uu apart, with the characters shared out between them
+	TArray<ACampFire*> Fires;
+	for (int32 Index = 0; Index < CampFireCount; ++Index)
+	{
+		const FTransform Transform(Origin + FVector(Index * 400.f, 0.f, 0.f));
+		ACampFire* Fire = World->SpawnActorDeferred<ACampFire>(ACampFire::StaticClass(), Transform);
+		Fire->DamageInterval = CampFireDamageInterval;
+		Fire->FinishSpawning(Transform);
+		Fires.Add(Fire);
+		SpawnedActors.Add(Fire);
+	}
+
+	for (int32 Index = 0; Index < CampFireCharacters && Fires.Num() > 0; ++Index)
+	{
+		SpawnCharacter(Fires[Index % Fires.Num()]->GetActorLocation());
+	}
+}
+
+void UStrikesBenchmarkSubsystem::SetUpProjectiles()
+{
+	UWorld* World = GetWorld();
+
+	// Six walls 100uu thick around a BoxSize cube
+	const float Half = BoxSize * 0.5f + 50.f;
+	const float Outer = BoxSize + 200.f;
+	SpawnWall(Origin + FVector(Half, 0.f, 0.f), FVector(100.f, Outer, Outer));
+	SpawnWall(Origin - FVector(Half, 0.f, 0.f), FVector(100.f, Outer, Outer));
+	SpawnWall(Origin + FVector(0.f, Half, 0.f), FVector(Outer, 100.f, Outer));
+	SpawnWall(Origin - FVector(0.f, Half, 0.f), FVector(Outer, 100.f, Outer));
+	SpawnWall(Origin + FVector(0.f, 0.f, Half), FVector(Outer, Outer, 100.f));
+	SpawnWall(Origin - FVector(0.f, 0.f, Half), FVector(Outer, Outer, 100.f));
+
+	// Same seed every run, so every run bounces the same way
+	FRandomStream Random(ProjectileCount);
+	const float Extent = BoxSize * 0.5f - 50.f;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	for (int32 Index = 0; Index < ProjectileCount; ++Index)
+	{
+		const FVector Location = Origin + FVector(Random.FRandRange(-Extent, Extent), Random.FRandRange(-Extent, Extent),
+		                                          Random.FRandRange(-Extent, Extent));
+		AStrikesProjectile* Projectile = World->SpawnActor<AStrikesProjectile>(
+			AStrikesProjectile::StaticClass(), Location, Random.VRand().Rotation(), SpawnParams);
+		if (Projectile == nullptr)
+		{
+			continue;
+		}
+
+		// Bounce forever without slowing down
+		Projectile->SetLifeSpan(0.f);
+		UProjectileMovementComponent* Movement = Projectile->GetProjectileMovement();
+		Movement->ProjectileGravityScale = 0.f;
+		Movement->Bounciness = 1.f;
+		Movement->Friction = 0.f;
+
+		SpawnedActors.Add(Projectile);
+	}
+}
+
+void UStrikesBenchmarkSubsystem::SetUpMedKitStorm()
+{
+	// Medkits on a grid 200uu apart
+	const int32 Columns = FMath::Max(FMath::CeilToInt(FMath::Sqrt(static_cast<float>(MedKitCount))), 1);
+	for (int32 Index = 0; Index < MedKitCount; ++Index)
+	{
+		const FVector Location = Origin + FVector((Index % Columns) * 200.f, (Index / Columns) * 200.f, 0.f);
+		MedKitLocations.Add(Location);
+		MedKits.Add(SpawnMedKit(Location));
+	}
+
+	for (int32 Index = 0; Index < MedKitCharacters; ++Index)
+	{
+		if (AStrikesCharacter* Character = SpawnCharacter(Origin - FVector(0.f, 400.f + Index * 200.f, 0.f)))
+		{
+			StormCharacters.Add(Character);
+		}
+	}
+}
+
+void UStrikesBenchmarkSubsystem::TickMedKitStorm()
+{
+	// Bring back every medkit picked up last frame, whether it was hidden or destroyed
+	for (int32 Index = 0; Index < MedKits.Num(); ++Index)
+	{
+		if (AMedKit* MedKit = MedKits[Index].Get())
+		{
+			if (MedKit->IsHidden())
+			{
+				MedKit->RestoreInitialState();
+			}
+		}
+		else
+		{
+			MedKits[Index] = SpawnMedKit(MedKitLocations[Index]);
+		}
+	}
+
+	// Hurt every character and teleport it onto a different medkit each frame
+	for (int32 Index = 0; Index < StormCharacters.Num() && MedKitLocations.Num() > 0; ++Index)
+	{
+		AStrikesCharacter* Character = StormCharacters[Index];
+		Character->UpdateHealth(-10.f);
+		Character->SetActorLocation(MedKitLocations[(Index + Frame) % MedKitLocations.Num()], false, nullptr,
+		                            ETeleportType::TeleportPhysics);
+	}
+}
+
+AStrikesCharacter* UStrikesBenchmarkSubsystem::SpawnCharacter(const FVector& Location)
+{
+	const AGameModeBase* GameMode = GetWorld()->GetAuthGameMode();
+	UClass* CharacterClass = GameMode != nullptr && GameMode->DefaultPawnClass != nullptr &&
+	                         GameMode->DefaultPawnClass->IsChildOf<AStrikesCharacter>()
+		                         ? GameMode->DefaultPawnClass.Get()
+		                         : AStrikesCharacter::StaticClass();
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AStrikesCharacter* Character = GetWorld()->SpawnActor<AStrikesCharacter>(
+		CharacterClass, Location, FRotator::ZeroRotator, SpawnParams);
+	if (Character == nullptr)
+	{
+		return nullptr;
+	}
+
+	// Nothing to stand on up here, so don't fall
+	Character->GetCharacterMovement()->DisableMovement();
+	Character->OnDied.AddUniqueDynamic(this, &UStrikesBenchmarkSubsystem::OnCharacterDied);
+
+	SpawnedActors.Add(Character);
+	return Character;
+}
+
+AMedKit* UStrikesBenchmarkSubsystem::SpawnMedKit(const FVector& Location)
+{
+	const FTransform Transform(Location);
+	AMedKit* MedKit = GetWorld()->SpawnActorDeferred<AMedKit>(AMedKit::StaticClass(), Transform);
+
+	USphereComponent* Trigger = NewObject<USphereComponent>(MedKit, TEXT("BenchmarkTrigger"));
+	Trigger->InitSphereRadius(50.f);
+	Trigger->SetCollisionProfileName(TEXT("Trigger"));
+	MedKit->SetRootComponent(Trigger);
+	MedKit->AddInstanceComponent(Trigger);
+	Trigger->RegisterComponent();
+
+	MedKit->FinishSpawning(Transform);
+	return MedKit;
+}
+
+void UStrikesBenchmarkSubsystem::SpawnWall(const FVector& Location, const FVector& Size)
+{
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	AStaticMeshActor* Wall = GetWorld()->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator);
+	if (Wall == nullptr || Cube == nullptr)
+	{
+		return;
+	}
+
+	// The basic cube is 100uu on a side; static mobility would refuse a mesh set at runtime
+	Wall->SetMobility(EComponentMobility::Movable);
+	Wall->GetStaticMeshComponent()->SetStaticMesh(Cube);
+	Wall->SetActorScale3D(Size / 100.f);
+	SpawnedActors.Add(Wall);
+}
+
+void UStrikesBenchmarkSubsystem::OnCharacterDied(AStrikesCharacter* Character)
+{
+	Character->RestoreInitialState();
+}
+
+void UStrikesBenchmarkSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Current.Scenario == EStrikesBenchmarkScenario::EMedKitStorm)
+	{
+		TickMedKitStorm();
+	}
+
+	++Frame;
+	if (Frame == WarmupFrames)
+	{
+		// Everything the scenario allocates is in place once it has run for a while
+		const uint64 MemoryAfter = FPlatformMemory::GetStats().UsedPhysical;
+		Current.MemoryMB = MemoryAfter > MemoryBefore ? (MemoryAfter - MemoryBefore) / (1024.0 * 1024.0) : 0.0;
+		Current.Objects = GUObjectArray.GetObjectArrayNumMinusAvailable() - ObjectsBefore;
+	}
+	else if (Frame > WarmupFrames)
+	{
+		// Game thread work of the last frame, without the time spent waiting for the tick rate
+		GameThreadMs.Add(static_cast<float>((FApp::GetDeltaTime() - FApp::GetIdleTime()) * 1000.0));
+	}
+
+	if (Frame >= WarmupFrames + MeasureFrames)
+	{
+		TearDownScenario();
+
+		Queue.RemoveAt(0);
+		if (Queue.Num() > 0)
+		{
+			SetUpScenario();
+		}
+		else
+		{
+			Finish();
+		}
+	}
+}
+
+void UStrikesBenchmarkSubsystem::TearDownScenario()
+{
+	if (GameThreadMs.Num() > 0)
+	{
+		double Sum = 0.0;
+		for (const float Ms : GameThreadMs)
+		{
+			Sum += Ms;
+		}
+		Current.GameThreadMsAvg = Sum / GameThreadMs.Num();
+
+		GameThreadMs.Sort();
+		const int32 P95Index = FMath::Clamp(FMath::CeilToInt(GameThreadMs.Num() * 0.95f) - 1, 0, GameThreadMs.Num() - 1);
+		Current.GameThreadMsP95 = GameThreadMs[P95Index];
+	}
+
+	Results.Add(Current);
+
+	UE_LOG(LogStrikesBenchmark, Display, TEXT("Benchmark %s: %.3f ms avg, %.3f ms p95, %.1f MiB, %d objects"),
+	       GetScenarioName(Current.Scenario), Current.GameThreadMsAvg, Current.GameThreadMsP95, Current.MemoryMB,
+	       Current.Objects);
+
+	for (AActor* Actor : SpawnedActors)
+	{
+		if (IsValid(Actor))
+		{
+			Actor->Destroy();
+		}
+	}
+	SpawnedActors.Reset();
+
+	// Medkits are respawned during the storm, so they are tracked on their own
+	for (const TWeakObjectPtr<AMedKit>& MedKit : MedKits)
+	{
+		if (MedKit.IsValid())
+		{
+			MedKit->Destroy();
+		}
+	}
+	MedKits.Reset();
+	MedKitLocations.Reset();
+	StormCharacters.Reset();
+}
+
+const FStrikesBenchmarkBaseline* UStrikesBenchmarkSubsystem::FindBaseline(const EStrikesBenchmarkScenario Scenario) const
+{
+	const FString Name = GetScenarioName(Scenario);
+	return Baselines.FindByPredicate([&Name](const FStrikesBenchmarkBaseline& Entry) { return Entry.Scenario == Name; });
+}
+
+TArray<FString> UStrikesBenchmarkSubsystem::FindRegressions(const FStrikesBenchmarkResult& Result) const
+{
+	TArray<FString> Regressions;
+
+	const FStrikesBenchmarkBaseline* Baseline = FindBaseline(Result.Scenario);
+	if (Baseline == nullptr)
+	{
+		return Regressions;
+	}
+
+	const auto Check = [&Regressions, &Result](const TCHAR* Metric, const double Value, const double BaselineValue,
+	                                           const float Tolerance)
+	{
+		if (BaselineValue > 0.0 && Value > BaselineValue * (1.0 + Tolerance))
+		{
+			Regressions.Add(FString::Printf(TEXT("Benchmark %s: %s %.3f is over the baseline %.3f by more than %.0f%%"),
+			                                GetScenarioName(Result.Scenario), Metric, Value, BaselineValue,
+			                                Tolerance * 100.f));
+		}
+	};
+
+	Check(TEXT("game thread ms"), Result.GameThreadMsAvg, Baseline->GameThreadMs, GameThreadTolerance);
+	Check(TEXT("memory MiB"), Result.MemoryMB, Baseline->MemoryMB, MemoryTolerance);
+	Check(TEXT("objects"), Result.Objects, Baseline->Objects, ObjectsTolerance);
+	return Regressions;
+}
+
+void UStrikesBenchmarkSubsystem::RecordBaseline(const FStrikesBenchmarkResult& Result)
+{
+	const FString Name = GetScenarioName(Result.Scenario);
+	FStrikesBenchmarkBaseline* Baseline = Baselines.FindByPredicate([&Name](const FStrikesBenchmarkBaseline& Entry)
+	{
+		return Entry.Scenario == Name;
+	});
+	if (Baseline == nullptr)
+	{
+		Baseline = &Baselines.AddDefaulted_GetRef();
+		Baseline->Scenario = Name;
+	}
+
+	// Every measurement is stored, so memory and UObjects are checked as well as game thread time
+	Baseline->GameThreadMs = Result.GameThreadMsAvg;
+	Baseline->MemoryMB = Result.MemoryMB;
+	Baseline->Objects = Result.Objects;
+
+	UE_LOG(LogStrikesBenchmark, Display, TEXT("+Baselines=(Scenario=\"%s\",GameThreadMs=%.3f,MemoryMB=%.1f,Objects=%d)"),
+	       *Name, Baseline->GameThreadMs, Baseline->MemoryMB, Baseline->Objects);
+}
+
+void UStrikesBenchmarkSubsystem::Finish()
+{
+	FStrikesPerfReport Report;
+	int32 Failures = 0;
+
+	for (const FStrikesBenchmarkResult& Result : Results)
+	{
+		const FString Name = GetScenarioName(Result.Scenario);
+		Report.Add(Name + TEXT(".GameThreadMsAvg"), Result.GameThreadMsAvg);
+		Report.Add(Name + TEXT(".GameThreadMsP95"), Result.GameThreadMsP95);
+		Report.Add(Name + TEXT(".MemoryMB"), Result.MemoryMB);
+		Report.Add(Name + TEXT(".Objects"), Result.Objects);
+
+		if (bRecordBaselines)
+		{
+			RecordBaseline(Result);
+			continue;
+		}
+
+		if (FindBaseline(Result.Scenario) == nullptr)
+		{
+			UE_LOG(LogStrikesBenchmark, Error, TEXT("Benchmark %s has no baseline; record one with -StrikesBenchmarkRecord"),
+			       *Name);
+			++Failures;
+			continue;
+		}
+
+		for (const FString& Regression : FindRegressions(Result))
+		{
+			UE_LOG(LogStrikesBenchmark, Error, TEXT("%s"), *Regression);
+			++Failures;
+		}
+	}
+
+	if (bRecordBaselines)
+	{
+		// Saved/Config of this machine; copy the section into DefaultGame.ini to share it
+		SaveConfig();
+		UE_LOG(LogStrikesBenchmark, Display, TEXT("Benchmark baselines recorded in %s"), *GetClass()->GetConfigName());
+	}
+
+	const FString ReportPath = FPaths::ProfilingDir() / TEXT("Strikes") /
+		FString::Printf(TEXT("Benchmark-%s.csv"), *FDateTime::Now().ToString());
+	Report.Save(ReportPath);
+
+	UE_LOG(LogStrikesBenchmark, Display, TEXT("Benchmark finished: %d scenarios, %d failures, results in %s"),
+	       Results.Num(), Failures, *ReportPath);
+
+	if (bQuitWhenDone)
+	{
+		FPlatformMisc::RequestExitWithStatus(false, Failures > 0 ? 1 : 0);
+	}
+}
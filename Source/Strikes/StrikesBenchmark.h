@@ -0,0 +1,242 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "StrikesBenchmark.generated.h"
+
+class AMedKit;
+class AStrikesCharacter;
+
+/** Controlled scenario measured by -StrikesBenchmark */
+UENUM()
+enum class EStrikesBenchmarkScenario : uint8
+{
+	/** CampFireCount campfires with CampFireCharacters characters standing in them */
+	ECampFires,
+
+	/** ProjectileCount projectiles bouncing in a closed box */
+	EProjectiles,
+
+	/** MedKitCharacters hurt characters teleporting onto MedKitCount medkits every frame */
+	EMedKitStorm
+};
+
+/** Stored result a scenario is checked against; zero values are not checked */
+USTRUCT()
+struct FStrikesBenchmarkBaseline
+{
+	GENERATED_BODY()
+
+	/** Scenario name, as printed in the results */
+	UPROPERTY()
+	FString Scenario;
+
+	/** Average game thread milliseconds per frame */
+	UPROPERTY()
+	float GameThreadMs = 0.f;
+
+	/** Growth of the process's physical memory over the scenario's warmup, in MiB */
+	UPROPERTY()
+	float MemoryMB = 0.f;
+
+	/** UObjects alive after the warmup that weren't before the scenario */
+	UPROPERTY()
+	int32 Objects = 0;
+};
+
+/**
+ * Measurements of one scenario.
+ * Memory is the growth of the process's physical memory and objects the growth of the UObject array; individual heap
+ * allocations are not counted. Record the scenario with -trace=memory to see them in Unreal Insights.
+ */
+struct FStrikesBenchmarkResult
+{
+	EStrikesBenchmarkScenario Scenario = EStrikesBenchmarkScenario::ECampFires;
+	double GameThreadMsAvg = 0.0;
+	double GameThreadMsP95 = 0.0;
+	double MemoryMB = 0.0;
+	int32 Objects = 0;
+};
+
+/**
+ * Headless benchmark of the gameplay classes, started with -StrikesBenchmark (every scenario) or
+ * -StrikesBenchmark=Projectiles,MedKitStorm (some of them). Meant for -nullrhi runs on the build machine:
+ * StrikesServer -nullrhi -StrikesBenchmark
+ * The Strikes.Benchmark automation tests run the same scenarios one at a time.
+ *
+ * Each scenario is spawned far above the level, warmed up for WarmupFrames and measured for MeasureFrames:
+ * game thread milliseconds per frame (idle time excluded), and the physical memory and UObjects it added.
+ * Heap allocations are not counted.
+ * Results are written to Saved/Profiling/Strikes/Benchmark-<date>.csv and checked against Baselines with the
+ * tolerances below; the process exits with status 1 if any scenario regressed or has no baseline.
+ * With -StrikesBenchmarkRecord the results are stored as the baselines instead, in the machine's saved config.
+ */
+UCLASS(config=Game)
+class STRIKES_API UStrikesBenchmarkSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Where the scenarios are spawned, away from the level */
+	UPROPERTY(Config, EditAnywhere, Category="Benchmark")
+	FVector Origin = FVector(0.f, 0.f, 20000.f);
+
+	/** Frames run before measuring */
+	UPROPERTY(Config, EditAnywhere, Category="Benchmark")
+	int32 WarmupFrames = 60;
+
+	/** Frames measured */
+	UPROPERTY(Config, EditAnywhere, Category="Benchmark")
+	int32 MeasureFrames = 600;
+
+	UPROPERTY(Config, EditAnywhere, Category="Benchmark|CampFires")
+	int32 CampFireCount = 16;
+
+	UPROPERTY(Config, EditAnywhere, Category="Benchmark|CampFires")
+	int32 CampFireCharacters = 64;
+
+	/** Damage interval of the spawned campfires, shorter than in the level so damage runs often */
+	UPROPERTY(Config, EditAnywhere, Category="Benchmark|CampFires")
+	float CampFireDamageInterval = 0.1f;
+
+	UPROPERTY(Config, EditAnywhere, Category="Benchmark|Projectiles")
+	int32 ProjectileCount = 500;
+
+	/** Inner size of the box the projectiles bounce in */
+	UPROPERTY(Config, EditAnywhere, Category="Benchmark|Projectiles")
+	float BoxSize = 2000.f;
+
+	UPROPERTY(Config, EditAnywhere, Category="Benchmark|MedKitStorm")
+	int32 MedKitCount = 64;
+
+	UPROPERTY(Config, EditAnywhere, Category="Benchmark|MedKitStorm")
+	int32 MedKitCharacters = 32;
+
+	/** Stored results; a scenario without a baseline fails until one is recorded */
+	UPROPERTY(Config, EditAnywhere, Category="Benchmark")
+	TArray<FStrikesBenchmarkBaseline> Baselines;
+
+	/** Relative increase of game thread time allowed over the baseline */
+	UPROPERTY(Config, EditAnywhere, Category="Benchmark")
+	float GameThreadTolerance = 0.15f;
+
+	/** Relative increase of memory allowed over the baseline */
+	UPROPERTY(Config, EditAnywhere, Category="Benchmark")
+	float MemoryTolerance = 0.25f;
+
+	/** Relative increase of created UObjects allowed over the baseline */
+	UPROPERTY(Config, EditAnywhere, Category="Benchmark")
+	float ObjectsTolerance = 0.05f;
+
+	/** Whether a -StrikesBenchmark run quits once every scenario ran; automation tests never quit */
+	UPROPERTY(Config, EditAnywhere, Category="Benchmark")
+	bool bExitWhenDone = true;
+
+	/** Name of a scenario as used on the command line, in the results and in Baselines */
+	static const TCHAR* GetScenarioName(EStrikesBenchmarkScenario Scenario);
+
+	/** Every scenario, in the order a full run goes through them */
+	static TArray<EStrikesBenchmarkScenario> GetAllScenarios();
+
+	/**
+	 * Runs scenarios one after another, starting with the first one right away. Does nothing while a run is going on.
+	 *
+	 * @param Scenarios Scenarios to run.
+	 * @param bQuitWhenDone Whether to quit with status 1 on a regression, or 0, once the last scenario ran.
+	 */
+	void Run(const TArray<EStrikesBenchmarkScenario>& Scenarios, bool bQuitWhenDone);
+
+	/** Whether scenarios are still running */
+	bool IsRunning() const { return Queue.Num() > 0; }
+
+	/** Results of the scenarios of the last run finished so far */
+	const TArray<FStrikesBenchmarkResult>& GetResults() const { return Results; }
+
+	/** Baseline of a scenario, or null if it has none */
+	const FStrikesBenchmarkBaseline* FindBaseline(EStrikesBenchmarkScenario Scenario) const;
+
+	/** Describes every measurement of a result that is over its baseline by more than its tolerance */
+	TArray<FString> FindRegressions(const FStrikesBenchmarkResult& Result) const;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	// End of FTickableGameObject interface
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Spawns the actors of the current scenario */
+	void SetUpScenario();
+
+	/** Destroys the actors of the current scenario and stores its result */
+	void TearDownScenario();
+
+	void SetUpCampFires();
+	void SetUpProjectiles();
+	void SetUpMedKitStorm();
+
+	/** Hurts every storm character and moves it onto the next medkit, bringing picked up medkits back */
+	void TickMedKitStorm();
+
+	/** Spawns a benchmark character that stands still where it is put */
+	AStrikesCharacter* SpawnCharacter(const FVector& Location);
+
+	/**
+	 * Spawns a medkit with a trigger sphere, since the native class has no collision of its own.
+	 * Medkits are respawned during the storm, so they are kept in MedKits rather than SpawnedActors.
+	 */
+	AMedKit* SpawnMedKit(const FVector& Location);
+
+	/** Spawns a cube scaled to the given size, for the walls of the projectile box */
+	void SpawnWall(const FVector& Location, const FVector& Size);
+
+	/** Keeps benchmark characters alive so the scenario load stays constant */
+	UFUNCTION()
+	void OnCharacterDied(AStrikesCharacter* Character);
+
+	/** Writes the results, checks them against Baselines or records them, and quits if configured to */
+	void Finish();
+
+	/** Stores a result as its scenario's baseline */
+	void RecordBaseline(const FStrikesBenchmarkResult& Result);
+
+	/** Scenarios still to run, current one first */
+	TArray<EStrikesBenchmarkScenario> Queue;
+
+	/** Actors spawned by the current scenario */
+	UPROPERTY()
+	TArray<AActor*> SpawnedActors;
+
+	/** Medkits and characters of the storm scenario */
+	TArray<TWeakObjectPtr<AMedKit>> MedKits;
+	TArray<FVector> MedKitLocations;
+	UPROPERTY()
+	TArray<AStrikesCharacter*> StormCharacters;
+
+	/** Whether the current run quits when it is done */
+	bool bQuitWhenDone = false;
+
+	/** Whether the current run records its results as the baselines, from -StrikesBenchmarkRecord */
+	bool bRecordBaselines = false;
+
+	/** Frames run in the current scenario */
+	int32 Frame = 0;
+
+	/** Memory and UObjects before the current scenario was spawned */
+	uint64 MemoryBefore = 0;
+	int32 ObjectsBefore = 0;
+
+	/** Game thread time of the measured frames */
+	TArray<float> GameThreadMs;
+
+	/** Result of the current scenario, then of every finished one */
+	FStrikesBenchmarkResult Current;
+	TArray<FStrikesBenchmarkResult> Results;
+};
@@ -0,0 +1,154 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrikesBotController.h"
+#include "CampFire.h"
+#include "MedKit.h"
+#include "StrikesBots.h"
+#include "StrikesCharacter.h"
+#include "TP_WeaponComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "InputActionValue.h"
+
+AStrikesBotController::AStrikesBotController()
+{
+	WeaponClass = TSoftClassPtr<AActor>(FSoftObjectPath(TEXT("/Game/FirstPerson/Blueprints/BP_PickUp_Rifle.BP_PickUp_Rifle_C")));
+
+	// Bots are server-side only
+	bWantsPlayerState = false;
+	PrimaryActorTick.bCanEverTick = true;
+}
+
+void AStrikesBotController::OnPossess(APawn* InPawn)
+{
+	Super::OnPossess(InPawn);
+
+	BotCharacter = Cast<AStrikesCharacter>(InPawn);
+	if (BotCharacter == nullptr)
+	{
+		return;
+	}
+
+	// Drop a weapon on the bot; walking into it picks it up like a player would
+	if (UClass* LoadedWeaponClass = WeaponClass.LoadSynchronous())
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		GetWorld()->SpawnActor<AActor>(LoadedWeaponClass, BotCharacter->GetActorTransform(), SpawnParams);
+	}
+
+	// Spread the first decisions over the interval so bots don't all think on the same frame
+	TimeToDecision = Random.FRandRange(0.f, DecisionInterval);
+}
+
+void AStrikesBotController::Tick(const float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (BotCharacter == nullptr)
+	{
+		return;
+	}
+
+	if (UStrikesBotSubsystem* Bots = GetWorld()->GetSubsystem<UStrikesBotSubsystem>())
+	{
+		Bots->NotifyBotTick();
+	}
+
+	TimeToDecision -= DeltaSeconds;
+	if (TimeToDecision <= 0.f)
+	{
+		TimeToDecision += DecisionInterval;
+		Decide();
+	}
+
+	FVector2D MoveInput = WanderMove;
+	FVector2D LookInput = WanderLook * DeltaSeconds;
+
+	if (const AActor* Target = GoalActor.Get(); Target != nullptr && Goal != EStrikesBotGoal::EWander)
+	{
+		// Turn towards the goal and walk straight at it
+		const FVector ToTarget = Target->GetActorLocation() - BotCharacter->GetActorLocation();
+		const float DeltaYaw = FMath::FindDeltaAngleDegrees(GetControlRotation().Yaw, ToTarget.Rotation().Yaw);
+		LookInput = FVector2D(FMath::Clamp(DeltaYaw, -MaxLookRate * DeltaSeconds, MaxLookRate * DeltaSeconds), 0.f);
+		MoveInput = FVector2D(0.f, 1.f);
+	}
+
+	BotCharacter->Look(FInputActionValue(LookInput));
+	BotCharacter->Move(FInputActionValue(MoveInput));
+}
+
+void AStrikesBotController::Decide()
+{
+	// Heal when hurt, sometimes walk into a fire, otherwise wander
+	if (BotCharacter->GetHealth() < SeekMedKitBelowHealth)
+	{
+		Goal = EStrikesBotGoal::ESeekMedKit;
+		GoalActor = FindClosest(AMedKit::StaticClass());
+	}
+	else if (Random.FRand() < CampFireChance)
+	{
+		Goal = EStrikesBotGoal::ESeekCampFire;
+		GoalActor = FindClosest(ACampFire::StaticClass());
+	}
+	else
+	{
+		Goal = EStrikesBotGoal::EWander;
+	}
+
+	if (!GoalActor.IsValid())
+	{
+		Goal = EStrikesBotGoal::EWander;
+	}
+
+	WanderMove = FVector2D(Random.FRandRange(-1.f, 1.f), Random.FRandRange(-1.f, 1.f));
+	WanderLook = FVector2D(Random.FRandRange(-MaxLookRate, MaxLookRate), Random.FRandRange(-10.f, 10.f));
+
+	// Hold or release the trigger like a player, so shots go through the weapon's fire scheduler
+	const bool bWantsToFire = Random.FRand() < FireChance;
+	if (bWantsToFire != bHoldingTrigger)
+	{
+		if (UTP_WeaponComponent* Weapon = FindWeapon())
+		{
+			if (bWantsToFire)
+			{
+				Weapon->StartFire();
+			}
+			else
+			{
+				Weapon->StopFire();
+			}
+			bHoldingTrigger = bWantsToFire;
+		}
+	}
+}
+
+AActor* AStrikesBotController::FindClosest(UClass* ActorClass) const
+{
+	AActor* Closest = nullptr;
+	double ClosestDistSquared = TNumericLimits<double>::Max();
+
+	for (TActorIterator<AActor> It(GetWorld(), ActorClass); It; ++It)
+	{
+		// Consumed medkits stay in the world, hidden, when soft reset is on
+		if (It->IsHidden())
+		{
+			continue;
+		}
+
+		const double DistSquared = FVector::DistSquared(It->GetActorLocation(), BotCharacter->GetActorLocation());
+		if (DistSquared < ClosestDistSquared)
+		{
+			Closest = *It;
+			ClosestDistSquared = DistSquared;
+		}
+	}
+
+	return Closest;
+}
+
+UTP_WeaponComponent* AStrikesBotController::FindWeapon() const
+{
+	// AttachWeapon registers the weapon as an instance component of its holder
+	return BotCharacter->GetInstanceComponents().FindItemByClass<UTP_WeaponComponent>();
+}
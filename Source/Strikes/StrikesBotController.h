@@ -0,0 +1,108 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "StrikesBotController.generated.h"
+
+class AStrikesCharacter;
+class UTP_WeaponComponent;
+
+/** What a bot is currently doing */
+UENUM()
+enum class EStrikesBotGoal : uint8
+{
+	/** Walk and look around at random */
+	EWander,
+
+	/** Walk to the closest medkit */
+	ESeekMedKit,
+
+	/** Walk into the closest campfire */
+	ESeekCampFire
+};
+
+/**
+ * Load-generation bot.
+ * Plays through the same code paths as a player: it moves and looks with AStrikesCharacter::Move and Look,
+ * fires with UTP_WeaponComponent::StartFire and StopFire, and walks into medkits and campfires so their overlaps and damage run.
+ */
+UCLASS(config=Game)
+class STRIKES_API AStrikesBotController : public AAIController
+{
+	GENERATED_BODY()
+
+public:
+	AStrikesBotController();
+
+	/** Weapon pickup spawned on the bot so it has something to fire */
+	UPROPERTY(Config, EditAnywhere, Category="Bot")
+	TSoftClassPtr<AActor> WeaponClass;
+
+	/** Seconds between decisions */
+	UPROPERTY(Config, EditAnywhere, Category="Bot")
+	float DecisionInterval = 1.f;
+
+	/**
+	 * Chance at each decision to hold the trigger until the next one.
+	 * While held, the weapon fires at its own rate and fire mode, as long as the bot has magic.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Bot")
+	float FireChance = 0.5f;
+
+	/** Chance to head for a campfire at each decision */
+	UPROPERTY(Config, EditAnywhere, Category="Bot")
+	float CampFireChance = 0.2f;
+
+	/** Health percentage below which the bot heads for a medkit */
+	UPROPERTY(Config, EditAnywhere, Category="Bot")
+	float SeekMedKitBelowHealth = 0.5f;
+
+	/** Largest random look input per second, in degrees */
+	UPROPERTY(Config, EditAnywhere, Category="Bot")
+	float MaxLookRate = 90.f;
+
+	/** Seeds the bot's random behaviour */
+	void SetRandomSeed(const int32 Seed) { Random.Initialize(Seed); }
+
+	virtual void Tick(float DeltaSeconds) override;
+
+protected:
+	virtual void OnPossess(APawn* InPawn) override;
+
+private:
+	/** Picks a new goal, move and look input, and maybe fires */
+	void Decide();
+
+	/** Closest actor of the class to the bot, or null */
+	AActor* FindClosest(UClass* ActorClass) const;
+
+	/** Weapon the bot carries, once picked up */
+	UTP_WeaponComponent* FindWeapon() const;
+
+	/** Possessed character */
+	UPROPERTY()
+	AStrikesCharacter* BotCharacter = nullptr;
+
+	/** Actor the bot walks to for ESeekMedKit and ESeekCampFire */
+	TWeakObjectPtr<AActor> GoalActor;
+
+	/** Current goal */
+	EStrikesBotGoal Goal = EStrikesBotGoal::EWander;
+
+	/** Move input while wandering */
+	FVector2D WanderMove = FVector2D::ZeroVector;
+
+	/** Look input per second while wandering */
+	FVector2D WanderLook = FVector2D::ZeroVector;
+
+	/** Whether the bot is holding the trigger of its weapon */
+	bool bHoldingTrigger = false;
+
+	/** Seconds until the next decision */
+	float TimeToDecision = 0.f;
+
+	/** Random stream seeded per bot, so runs with the same bot count behave the same */
+	FRandomStream Random;
+};
@@ -0,0 +1,185 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrikesBots.h"
+#include "StrikesBotController.h"
+#include "StrikesCharacter.h"
+#include "TP_WeaponComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerStart.h"
+#include "HAL/FileManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogStrikesBots, Log, All);
+
+bool UStrikesBotSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// Only game worlds have bots
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UStrikesBotSubsystem::IsTickable() const
+{
+	// Metrics are only recorded for bot runs
+	return Bots.Num() > 0;
+}
+
+TStatId UStrikesBotSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UStrikesBotSubsystem, STATGROUP_Tickables);
+}
+
+void UStrikesBotSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	int32 NumBots = 0;
+	if (FParse::Value(FCommandLine::Get(), TEXT("StrikesBots="), NumBots))
+	{
+		SpawnBots(NumBots);
+	}
+}
+
+void UStrikesBotSubsystem::SpawnBots(const int32 NumBots)
+{
+	UWorld* World = GetWorld();
+	if (NumBots <= 0 || Bots.Num() > 0)
+	{
+		return;
+	}
+
+	// Bots are driven by the server; clients of a bot server just see them replicate
+	const AGameModeBase* GameMode = World->GetAuthGameMode();
+	if (GameMode == nullptr || GameMode->DefaultPawnClass == nullptr)
+	{
+		return;
+	}
+
+	TArray<FVector> Origins;
+	for (TActorIterator<APlayerStart> It(World); It; ++It)
+	{
+		Origins.Add(It->GetActorLocation());
+	}
+	if (Origins.Num() == 0)
+	{
+		Origins.Add(FVector::ZeroVector);
+	}
+
+	Bots.Reserve(NumBots);
+	for (int32 Index = 0; Index < NumBots; ++Index)
+	{
+		SpawnBot(Index, GameMode->DefaultPawnClass, Origins);
+	}
+
+	MetricsPath = FPaths::ProfilingDir() / TEXT("Strikes") /
+		FString::Printf(TEXT("Bots-%d-%s.csv"), Bots.Num(), *FDateTime::Now().ToString());
+	FFileHelper::SaveStringToFile(
+		TEXT("Seconds,Bots,AvgFrameMs,MaxFrameMs,Frames,BotTicks,ProjectilesFired,DamageEvents,DamageTaken\n"),
+		*MetricsPath);
+
+	RunStartTime = FPlatformTime::Seconds();
+	SecondStartTime = RunStartTime;
+	ShotsAtSecondStart = CountShotsFired();
+
+	UE_LOG(LogStrikesBots, Display, TEXT("Spawned %d bots, writing metrics to %s"), Bots.Num(), *MetricsPath);
+}
+
+void UStrikesBotSubsystem::SpawnBot(const int32 Index, UClass* PawnClass, const TArray<FVector>& Origins)
+{
+	UWorld* World = GetWorld();
+
+	// Spread the bots in rings around the player starts
+	const FVector Origin = Origins[Index % Origins.Num()];
+	const float Angle = Index * 2.39996f; // golden angle
+	const float Distance = SpawnRadius * FMath::Sqrt((Index + 1.f) / (Index + 2.f));
+	const FVector Location = Origin + FVector(FMath::Cos(Angle) * Distance, FMath::Sin(Angle) * Distance, 0.f);
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	AStrikesCharacter* Character = World->SpawnActor<AStrikesCharacter>(
+		PawnClass, Location, FRotator(0.f, FMath::RadiansToDegrees(Angle), 0.f), SpawnParams);
+	if (Character == nullptr)
+	{
+		return;
+	}
+
+	AStrikesBotController* Bot = World->SpawnActor<AStrikesBotController>();
+	Bot->SetRandomSeed(Index);
+	Bot->Possess(Character);
+	Bots.Add(Bot);
+
+	TrackBotCharacter(Character);
+}
+
+void UStrikesBotSubsystem::TrackBotCharacter(AStrikesCharacter* Character)
+{
+	Character->OnDied.AddUniqueDynamic(this, &UStrikesBotSubsystem::OnBotDied);
+	Character->OnTakeAnyDamage.AddUniqueDynamic(this, &UStrikesBotSubsystem::OnBotDamaged);
+}
+
+void UStrikesBotSubsystem::OnBotDied(AStrikesCharacter* Character)
+{
+	// Keep the population constant: a dead bot comes back with full health where it spawned
+	Character->RestoreInitialState();
+}
+
+void UStrikesBotSubsystem::OnBotDamaged(AActor* DamagedActor, const float Damage, const UDamageType* DamageType,
+                                        AController* InstigatedBy, AActor* DamageCauser)
+{
+	++DamageEvents;
+	DamageTaken += Damage;
+}
+
+int64 UStrikesBotSubsystem::CountShotsFired() const
+{
+	int64 Shots = 0;
+	for (TActorIterator<AStrikesCharacter> It(GetWorld()); It; ++It)
+	{
+		if (const UTP_WeaponComponent* Weapon = It->GetInstanceComponents().FindItemByClass<UTP_WeaponComponent>())
+		{
+			Shots += Weapon->GetShotsFired();
+		}
+	}
+	return Shots;
+}
+
+void UStrikesBotSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double FrameMs = DeltaTime * 1000.0;
+	FrameMsSum += FrameMs;
+	MaxFrameMs = FMath::Max(MaxFrameMs, FrameMs);
+	++Frames;
+
+	const double Now = FPlatformTime::Seconds();
+	if (Now - SecondStartTime >= 1.0)
+	{
+		WriteMetricsRow(Now);
+	}
+}
+
+void UStrikesBotSubsystem::WriteMetricsRow(const double Now)
+{
+	const int64 Shots = CountShotsFired();
+
+	const FString Row = FString::Printf(TEXT("%.1f,%d,%.3f,%.3f,%d,%d,%lld,%d,%.1f\n"),
+	                                    Now - RunStartTime, Bots.Num(), Frames > 0 ? FrameMsSum / Frames : 0.0,
+	                                    MaxFrameMs, Frames, BotTicks, Shots - ShotsAtSecondStart, DamageEvents,
+	                                    DamageTaken);
+	FFileHelper::SaveStringToFile(Row, *MetricsPath, FFileHelper::EEncodingOptions::AutoDetect,
+	                              &IFileManager::Get(), FILEWRITE_Append);
+
+	SecondStartTime = Now;
+	ShotsAtSecondStart = Shots;
+	FrameMsSum = 0.0;
+	MaxFrameMs = 0.0;
+	Frames = 0;
+	BotTicks = 0;
+	DamageEvents = 0;
+	DamageTaken = 0.f;
+}
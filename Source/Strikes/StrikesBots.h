@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "StrikesBots.generated.h"
+
+class AStrikesBotController;
+class AStrikesCharacter;
+
+/**
+ * Spawns load-generation bots when the game is started with -StrikesBots=N, and writes one CSV row of metrics
+ * per second to Saved/Profiling/Strikes: frame time, frames and bot ticks, projectiles fired and damage taken.
+ * Meant for headless servers: StrikesServer FirstPersonMap -nullrhi -StrikesBots=200
+ */
+UCLASS(config=Game)
+class STRIKES_API UStrikesBotSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Radius in uu around the player starts that bots are spread over */
+	UPROPERTY(Config, EditAnywhere, Category="Bot")
+	float SpawnRadius = 1500.f;
+
+	/**
+	 * Spawns bots around the player starts and starts writing the metrics file.
+	 * Only the server can spawn bots; does nothing on clients or if bots were already spawned.
+	 *
+	 * @param NumBots Number of bots to spawn.
+	 */
+	void SpawnBots(int32 NumBots);
+
+	/**
+	 * Counts the damage a bot's character takes for the metrics, and brings it back where it started when it dies.
+	 *
+	 * @param Character The character possessed by the bot.
+	 */
+	void TrackBotCharacter(AStrikesCharacter* Character);
+
+	/** Counts a bot controller tick for the metrics */
+	void NotifyBotTick() { ++BotTicks; }
+
+	/** Damage events bots took in the current second of the metrics */
+	int32 GetDamageEvents() const { return DamageEvents; }
+
+	/** Damage bots took in the current second of the metrics */
+	float GetDamageTaken() const { return DamageTaken; }
+
+	/** Number of bots spawned */
+	UFUNCTION(BlueprintPure, Category="Bot")
+	int32 GetNumBots() const { return Bots.Num(); }
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	// End of FTickableGameObject interface
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Spawns a bot character and its controller */
+	void SpawnBot(int32 Index, UClass* PawnClass, const TArray<FVector>& Origins);
+
+	/** Brings a dead bot back where it started */
+	UFUNCTION()
+	void OnBotDied(AStrikesCharacter* Character);
+
+	/** Counts damage taken by a bot */
+	UFUNCTION()
+	void OnBotDamaged(AActor* DamagedActor, float Damage, const UDamageType* DamageType,
+	                  AController* InstigatedBy, AActor* DamageCauser);
+
+	/** Appends the metrics of the last second to the CSV file and starts a new second */
+	void WriteMetricsRow(double Now);
+
+	/** Shots fired by every character's weapon so far */
+	int64 CountShotsFired() const;
+
+	/** Spawned bot controllers */
+	UPROPERTY()
+	TArray<AStrikesBotController*> Bots;
+
+	/** CSV file the metrics are appended to */
+	FString MetricsPath;
+
+	/** Real time the run and the current second started */
+	double RunStartTime = 0.0;
+	double SecondStartTime = 0.0;
+
+	/** Metrics of the current second */
+	double FrameMsSum = 0.0;
+	double MaxFrameMs = 0.0;
+	int32 Frames = 0;
+	int32 BotTicks = 0;
+	int32 DamageEvents = 0;
+	float DamageTaken = 0.f;
+
+	/** Shots fired at the start of the current second */
+	int64 ShotsAtSecondStart = 0;
+};
@@ -1,17 +1,26 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "StrikesCharacter.h"
+#include "StrikesAttributes.h"
+#include "StrikesGameMode.h"
+#include "StrikesLevelReset.h"
 #include "StrikesProjectile.h"
+#include "StrikesStats.h"
+#include "TP_WeaponComponent.h"
 #include "Animation/AnimInstance.h"
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "InputActionValue.h"
 #include "Engine/LocalPlayer.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerState.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "Kismet/KismetMathLibrary.h"
-#include "TimerManager.h"
 
 DEFINE_LOG_CATEGORY(LogTemplateCharacter);
 
@@ -37,6 +46,43 @@ AStrikesCharacter::AStrikesCharacter()
 	Mesh1P->CastShadow = false;
 	Mesh1P->SetRelativeRotation(FRotator(0.9f, -19.19f, 5.2f));
 	Mesh1P->SetRelativeLocation(FVector(-30.f, 0.f, -150.f));
+
+	// Magic is evaluated on read, so the character itself doesn't need to tick
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	// Same length as the FTimeline that used to play the magic curve
+	MagicCurveLength = 5.f;
+
+	// Cooldown windows are kept as world timestamps and checked on read
+	InvincibilityDuration = 2.f;
+	MagicRegenDelay = 5.f;
+	MagicPredictionTimeout = 1.f;
+
+	// Health and magic live in the attribute store once the character is in a game world
+	AttributeSubsystem = nullptr;
+}
+
+void AStrikesCharacter::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Registered before BeginPlay, since replicated health and magic can arrive first
+	AttributeSubsystem = GetWorld()->GetSubsystem<UStrikesAttributeSubsystem>();
+	if (AttributeSubsystem != nullptr)
+	{
+		AttributeHandle = AttributeSubsystem->Register(this, GetMagicRules());
+	}
+}
+
+void AStrikesCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (AttributeSubsystem != nullptr)
+	{
+		AttributeSubsystem->Unregister(AttributeHandle);
+		AttributeSubsystem = nullptr;
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AStrikesCharacter::BeginPlay()
@@ -44,60 +90,364 @@ void AStrikesCharacter::BeginPlay()
 	// Call the base class  
 	Super::BeginPlay();
 
-	// Initialize health-related properties.
+	InitializeAttributes();
+
+	// Let the game mode follow this character's health changes.
+	if (AStrikesGameMode* GameMode = GetWorld()->GetAuthGameMode<AStrikesGameMode>())
+	{
+		GameMode->RegisterCharacter(this);
+	}
+
+	// Remember where we started so a soft reset can put us back
+	InitialTransform = GetActorTransform();
+	InitialControlRotation = GetControlRotation();
+
+	if (UStrikesLevelResetSubsystem* ResetSubsystem = GetWorld()->GetSubsystem<UStrikesLevelResetSubsystem>())
+	{
+		ResetSubsystem->Register(this);
+	}
+}
+
+void AStrikesCharacter::InitializeAttributes()
+{
+	// Full health, with no invincibility or flash left over from a previous round.
+	FStrikesHealthState HealthState = GetHealthCoreState();
+	StrikesHealth::Reset(HealthState);
+	SetHealthCoreState(HealthState);
+
+	// Full magic, with no cooldown, curve or regeneration left over from a previous round.
+	const FStrikesMagicRules Rules = GetMagicRules();
+	FStrikesMagicState MagicState = GetMagicCoreState();
+	StrikesMagic::Reset(MagicState, Rules);
+	SetMagicCoreState(MagicState);
+
+	// Pick up tuning changed since the character was registered
+	const int32 Index = GetAttributeIndex();
+	if (Index != INDEX_NONE)
+	{
+		AttributeSubsystem->GetStore().SetMagicRules(Index, Rules);
+	}
+
+	// Predictions made before the reset no longer apply
+	PendingMagicPredictions.Reset();
+
+	MarkHealthDirty();
+	MarkMagicDirty();
+}
+
+void AStrikesCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// Health and magic only change in UpdateHealth and the magic setters, which mark them dirty,
+	// so they are only compared and sent after an actual change.
+	FDoRepLifetimeParams SharedParams;
+	SharedParams.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(AStrikesCharacter, NetHealth, SharedParams);
+
+	// Only the owning player shows magic and the damage flash
+	FDoRepLifetimeParams OwnerParams;
+	OwnerParams.bIsPushBased = true;
+	OwnerParams.Condition = COND_OwnerOnly;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(AStrikesCharacter, bRedFlash, OwnerParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AStrikesCharacter, NetMagic, OwnerParams);
+}
+
+void AStrikesCharacter::MarkHealthDirty()
+{
+	const FStrikesHealthState State = GetHealthCoreState();
+	NetHealth.HealthPercentage = State.Percentage;
+	bRedFlash = State.bRedFlash;
+
+	MARK_PROPERTY_DIRTY_FROM_NAME(AStrikesCharacter, NetHealth, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(AStrikesCharacter, bRedFlash, this);
+}
+
+void AStrikesCharacter::MarkMagicDirty()
+{
+	// Predicted changes on the owning client stay local
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	WriteMagicState(NetMagic);
+
+	MARK_PROPERTY_DIRTY_FROM_NAME(AStrikesCharacter, NetMagic, this);
+}
+
+void AStrikesCharacter::WriteMagicState(FStrikesNetMagic& OutState) const
+{
+	const FStrikesMagicState State = GetMagicCoreState();
+	const float FullMagic = GetFullMagic();
+
+	OutState.MagicFraction = FullMagic > 0.f ? State.Magic / FullMagic : 0.f;
+	OutState.MagicPercentage = State.Percentage;
+	OutState.PreviousMagic = State.PreviousPercentage;
+	OutState.MagicValue = State.CurveDelta;
+	OutState.MagicCurveStartTime = static_cast<float>(State.CurveStartTime);
+	OutState.MagicUsableTime = static_cast<float>(State.UsableTime);
+	OutState.MagicRegenTime = static_cast<float>(State.RegenTime);
+	OutState.bMagicCurvePlaying = State.bCurvePlaying;
+	OutState.bMagicRegenPending = State.bRegenPending;
+	OutState.AckedPredictionKey = AckedPredictionKey;
+	OutState.bAckedPredictionFired = bAckedPredictionFired;
+}
+
+void AStrikesCharacter::ReadMagicState(const FStrikesNetMagic& NetState)
+{
+	FStrikesMagicState State;
+	State.Magic = NetState.MagicFraction * GetFullMagic();
+	State.Percentage = NetState.MagicPercentage;
+	State.PreviousPercentage = NetState.PreviousMagic;
+	State.CurveDelta = NetState.MagicValue;
+	State.CurveStartTime = NetState.MagicCurveStartTime;
+	State.UsableTime = NetState.MagicUsableTime;
+	State.RegenTime = NetState.MagicRegenTime;
+	State.bCurvePlaying = NetState.bMagicCurvePlaying;
+	State.bRegenPending = NetState.bMagicRegenPending;
+	State.bCoolingDown = NetState.MagicUsableTime > GetServerTime();
+	SetMagicCoreState(State);
+}
+
+int32 AStrikesCharacter::GetAttributeIndex() const
+{
+	return AttributeSubsystem != nullptr ? AttributeSubsystem->GetStore().GetIndex(AttributeHandle) : INDEX_NONE;
+}
+
+FStrikesHealthState AStrikesCharacter::GetHealthCoreState() const
+{
+	const int32 Index = GetAttributeIndex();
+	return Index != INDEX_NONE ? AttributeSubsystem->GetStore().GetHealth(Index) : FStrikesHealthState();
+}
 
-	// Set the maximum health value.
-	FullHealth = 1000.f;
+void AStrikesCharacter::SetHealthCoreState(const FStrikesHealthState& State)
+{
+	const int32 Index = GetAttributeIndex();
+	if (Index != INDEX_NONE)
+	{
+		AttributeSubsystem->GetStore().SetHealth(Index, State);
+	}
+}
 
-	// Set the current health to the maximum value.
-	Health = FullHealth;
+FStrikesMagicState AStrikesCharacter::GetMagicCoreState() const
+{
+	const int32 Index = GetAttributeIndex();
+	return Index != INDEX_NONE ? AttributeSubsystem->GetStore().GetMagic(Index) : FStrikesMagicState();
+}
 
-	// Set the health percentage to 100%.
-	HealthPercentage = 1.f;
+void AStrikesCharacter::SetMagicCoreState(const FStrikesMagicState& State)
+{
+	const int32 Index = GetAttributeIndex();
+	if (Index != INDEX_NONE)
+	{
+		AttributeSubsystem->GetStore().SetMagic(Index, State);
+	}
+}
 
-	// Allow the character to be damaged.
-	bCanBeDamaged = true;
+void AStrikesCharacter::OnMagicSettled()
+{
+	MarkMagicDirty();
 
-	// Initialize magic-related properties.
+	// The settle loop also ends the cooldown, which is what the overheat shows
+	if (bOverheated && CanUseMagic())
+	{
+		OnOverheatEnded();
+	}
+}
 
-	// Set the maximum magic value.
-	FullMagic = 100.f;
+void AStrikesCharacter::OnStoreDamage(const bool bDied, const float DamageAmount, const FDamageEvent& DamageEvent,
+                                      AController* EventInstigator, AActor* DamageCauser)
+{
+	// Same notifications as TakeDamage; the flash is sent even if health didn't change
+	MarkHealthDirty();
 
-	// Set the current magic to the maximum value.
-	Magic = FullMagic;
+	const FStrikesHealthState State = GetHealthCoreState();
+	if (bDied)
+	{
+		NotifyHealthChange(EStrikesHealthChange::EDied);
+	}
+	else if (State.Percentage != State.PreviousPercentage)
+	{
+		NotifyHealthChange(EStrikesHealthChange::EChanged);
+	}
 
-	// Set the magic percentage to 100%.
-	MagicPercentage = 1.f;
+	// OnTakeAnyDamage and the Blueprint damage events, which bots and damage types listen to
+	Super::TakeDamage(DamageAmount, DamageEvent, EventInstigator, DamageCauser);
+}
 
-	// Store the current magic percentage as the previous value.
-	PreviousMagic = MagicPercentage;
+FStrikesMagicRules AStrikesCharacter::GetMagicRules() const
+{
+	FStrikesMagicRules Rules;
+	Rules.AmountScale = GetHealthCoreState().FullHealth;
+	Rules.CurveLength = MagicCurveLength;
+	Rules.RegenDelay = MagicRegenDelay;
+	Rules.Curve = GetBakedMagicCurve();
+	return Rules;
+}
 
-	// Initialize the magic value to 0.
-	MagicValue = 0.f;
+const FStrikesCoreCurve* AStrikesCharacter::GetBakedMagicCurve() const
+{
+	if (!MagicCurve)
+	{
+		return nullptr;
+	}
 
-	// Allow the character to use magic.
-	bCanUseMagic = true;
+	// Baked on first use, and again if the curve or its length are changed
+	if (BakedMagicCurveSource != MagicCurve || BakedMagicCurve.Length != MagicCurveLength)
+	{
+		BakedMagicCurve.Bake(MagicCurveLength, FStrikesCoreCurve::DefaultNumSamples, [this](const float Time)
+		{
+			return MagicCurve->GetFloatValue(Time);
+		});
+		BakedMagicCurveSource = MagicCurve;
+	}
+
+	return &BakedMagicCurve;
+}
+
+uint16 AStrikesCharacter::PredictMagicSpend()
+{
+	// Same spend the server applies when the shot is fired
+	InitializeMagicTimers();
+
+	// 0 is reserved for "no prediction"
+	LastPredictionKey = LastPredictionKey == MAX_uint16 ? 1 : LastPredictionKey + 1;
+
+	FStrikesMagicPrediction& Prediction = PendingMagicPredictions.AddDefaulted_GetRef();
+	Prediction.Key = LastPredictionKey;
+	Prediction.Time = GetServerTime();
+	WriteMagicState(Prediction.State);
+
+	return Prediction.Key;
+}
+
+void AStrikesCharacter::AcknowledgePrediction(const uint16 PredictionKey, const bool bFired)
+{
+	if (PredictionKey == 0)
+	{
+		return;
+	}
 
+	// Sent with the magic state the shot produced, or the unchanged state if it wasn't fired
+	AckedPredictionKey = PredictionKey;
+	bAckedPredictionFired = bFired;
+	MarkMagicDirty();
+}
+
+void AStrikesCharacter::OnRep_NetHealth(const FStrikesNetHealth& OldNetHealth)
+{
+	// Clients learn about health changes here instead of in UpdateHealth
+	FStrikesHealthState State = GetHealthCoreState();
+	State.PreviousPercentage = OldNetHealth.HealthPercentage;
+	State.Percentage = NetHealth.HealthPercentage;
+	State.Health = State.Percentage * State.FullHealth;
+	SetHealthCoreState(State);
+
+	OnHealthChanged.Broadcast(this, State.Percentage);
+}
+
+void AStrikesCharacter::OnRep_NetMagic()
+{
+	ReadMagicState(NetMagic);
+
+	// Reconcile predicted spends: answered ones are settled by the server state, which rolls back any it didn't fire
+	const double Now = GetServerTime();
+	bool bRejected = false;
+	for (int32 Index = 0; Index < PendingMagicPredictions.Num(); ++Index)
+	{
+		const FStrikesMagicPrediction& Prediction = PendingMagicPredictions[Index];
+		if (StrikesNet::IsKeyAtOrBefore(Prediction.Key, NetMagic.AckedPredictionKey))
+		{
+			// Only the latest answer says whether its shot went out; older answers merged into this update
+			bRejected |= Prediction.Key == NetMagic.AckedPredictionKey && !NetMagic.bAckedPredictionFired;
+		}
+		else if (Now - Prediction.Time < MagicPredictionTimeout)
+		{
+			continue;
+		}
+
+		PendingMagicPredictions.RemoveAt(Index--, 1, EAllowShrinking::No);
+	}
 
-	if (MagicCurve)
+	// Keep showing the newest unanswered prediction over updates the server sent before it saw the shot
+	if (PendingMagicPredictions.Num() > 0)
 	{
-		FOnTimelineFloat TimelineCallback;
-		FOnTimelineEventStatic TimelineFinishedCallback;
+		ReadMagicState(PendingMagicPredictions.Last().State);
+	}
 
-		TimelineCallback.BindUFunction(this, FName("SetMagicValue"));
-		TimelineFinishedCallback.BindUFunction(this, FName("SetMagicState"));
-		MyTimeline.AddInterpFloat(MagicCurve, TimelineCallback);
-		MyTimeline.SetTimelineFinishedFunc(TimelineFinishedCallback);
+	if (bRejected)
+	{
+		OnMagicPredictionRejected.Broadcast();
 	}
+
+	OnMagicChanged.Broadcast(this);
+
+	// Mirror the server's overheat window so the weapon material follows it; the settle loop ends it
+	TriggerOverheat(!CanUseMagic());
+}
+
+double AStrikesCharacter::GetServerTime() const
+{
+	// Timestamps are set by the server and replicated, so every machine reads them against the server's clock
+	const UWorld* World = GetWorld();
+	const AGameStateBase* GameState = World->GetGameState();
+
+	return GameState != nullptr ? GameState->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
 }
 
-void AStrikesCharacter::Tick(const float DeltaTime)
+double AStrikesCharacter::GetViewTime() const
 {
-	Super::Tick(DeltaTime);
+	// Other characters are shown as the server sent them, about half a round trip ago
+	const APlayerState* State = GetPlayerState();
+	const double HalfPing = State != nullptr ? State->GetPingInMilliseconds() * 0.0005 : 0.0;
 
-	MyTimeline.TickTimeline(DeltaTime);
+	return GetServerTime() - HalfPing;
 }
 
+void AStrikesCharacter::ServerStartFire_Implementation(const double ShooterViewTime, const uint16 PredictionKey)
+{
+	UTP_WeaponComponent* Weapon = GetInstanceComponents().FindItemByClass<UTP_WeaponComponent>();
+	if (Weapon == nullptr)
+	{
+		AcknowledgePrediction(PredictionKey, false);
+		return;
+	}
+
+	// The weapon acknowledges the prediction once the predicted shot is fired, which can wait for the fire rate
+	Weapon->SetShooterViewTime(ShooterViewTime);
+	Weapon->SetPredictionKey(PredictionKey);
+	Weapon->StartFire();
+}
+
+void AStrikesCharacter::ServerStopFire_Implementation()
+{
+	if (UTP_WeaponComponent* Weapon = GetInstanceComponents().FindItemByClass<UTP_WeaponComponent>())
+	{
+		Weapon->StopFire();
+	}
+}
+
+void AStrikesCharacter::RestoreInitialState()
+{
+	// Put the character back where it started and stop any movement.
+	SetActorTransform(InitialTransform, false, nullptr, ETeleportType::ResetPhysics);
+	GetCharacterMovement()->StopMovementImmediately();
+
+	if (Controller != nullptr)
+	{
+		Controller->SetControlRotation(InitialControlRotation);
+	}
+
+	InitializeAttributes();
+
+	// Let listeners (weapon material, HUD) catch up with the restored values.
+	TriggerOverheat(false);
+	OnHealthChanged.Broadcast(this, GetHealth());
+	OnMagicChanged.Broadcast(this);
+}
 
 //////////////////////////////////////////////////////////////////////////// Input
 
@@ -128,19 +478,17 @@ void AStrikesCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCo
 
 void AStrikesCharacter::InitializeMagicTimers()
 {
-	// Stop the magic timeline to halt any ongoing animation or updates.
-	MyTimeline.Stop();
-
-	// Clear the existing magic timer to ensure no pending callbacks.
-	GetWorldTimerManager().ClearTimer(MagicTimerHandler);
+	// Spend the magic of a shot and schedule regeneration after a delay.
+	// Regeneration is applied lazily the next time magic is read or changed.
+	// A magic timer used to be cleared and set again here.
+	STRIKES_COUNT_EVENT(STAT_StrikesTimerOpsAvoided, EStrikesFrameEvent::ETimerOpAvoided, 2);
 
-	// Adjust the magic value by a fixed amount (e.g., reduce by 20 units).
-	SetMagicChange(-20.f);
+	FStrikesMagicState State = GetMagicCoreState();
+	const bool bCurveStarted = StrikesMagic::Spend(State, GetMagicRules(), GetServerTime());
+	SetMagicCoreState(State);
+	MarkMagicDirty();
 
-	// Set up a new timer to update magic value after a delay of 5 seconds.
-	GetWorldTimerManager().SetTimer(
-		MagicTimerHandler, this, &AStrikesCharacter::UpdateMagic, 5.f, false
-	);
+	NotifyMagicChange(bCurveStarted);
 }
 
 void AStrikesCharacter::Move(const FInputActionValue& Value)
@@ -161,31 +509,50 @@ void AStrikesCharacter::Look(const FInputActionValue& Value)
 	// input is a Vector2D
 	FVector2D LookAxisVector = Value.Get<FVector2D>();
 
-	if (Controller != nullptr)
+	if (Controller != nullptr && Controller->IsLocalPlayerController())
 	{
 		// add yaw and pitch input to controller
 		AddControllerYawInput(LookAxisVector.X);
 		AddControllerPitchInput(LookAxisVector.Y);
 	}
+	else if (Controller != nullptr)
+	{
+		// AI controllers have no input pipeline, so turn them directly
+		FRotator ControlRotation = Controller->GetControlRotation();
+		ControlRotation.Yaw += LookAxisVector.X;
+		ControlRotation.Pitch = FMath::ClampAngle(ControlRotation.Pitch + LookAxisVector.Y, -89.f, 89.f);
+		Controller->SetControlRotation(ControlRotation);
+	}
 }
 
 float AStrikesCharacter::GetHealth() const
 {
 	// Returns the current health percentage of the character.
-	return HealthPercentage;
+	return GetHealthCoreState().Percentage;
 }
 
 float AStrikesCharacter::GetMagic() const
 {
 	// Returns the current magic percentage of the character.
-	return MagicPercentage;
+	return StrikesMagic::GetPercentage(GetMagicCoreState(), GetMagicRules(), GetServerTime());
+}
+
+float AStrikesCharacter::GetMagicAmount() const
+{
+	// Returns the current magic amount of the character.
+	return StrikesMagic::GetAmount(GetMagicCoreState(), GetMagicRules(), GetServerTime());
+}
+
+float AStrikesCharacter::GetFullMagic() const
+{
+	return FStrikesMagicRules().FullMagic;
 }
 
 FText AStrikesCharacter::GetHealthIntText() const
 {
 	// Converts the health percentage to a formatted string showing the health as a percentage (e.g., "75%").
 
-	int32 HP = FMath::RoundHalfFromZero(HealthPercentage * 100);
+	int32 HP = FMath::RoundHalfFromZero(GetHealth() * 100);
 	FString HPS = FString::FromInt(HP);
 	FString HealthHUD = HPS + FString(TEXT("%"));
 	FText HPText = FText::FromString(HealthHUD);
@@ -197,46 +564,129 @@ FText AStrikesCharacter::GetMagicIntText() const
 {
 	// Converts the current and full magic values to a formatted string (e.g., "30/100").
 
-	const int32 MP = FMath::RoundHalfFromZero(MagicPercentage * 100);
+	const int32 MP = FMath::RoundHalfFromZero(GetMagic() * 100);
 	const FString MPS = FString::FromInt(MP);
-	const FString FullMPS = FString::FromInt(FullMagic);
+	const FString FullMPS = FString::FromInt(GetFullMagic());
 	const FString MagicHUD = MPS + FString(TEXT("/") + FullMPS);
 	const FText MagicText = FText::FromString(MagicHUD);
 
 	return MagicText;
 }
 
+bool AStrikesCharacter::IsDamageable() const
+{
+	// The character can be damaged once the invincibility window has passed.
+	return StrikesHealth::IsDamageable(GetHealthCoreState(), GetServerTime());
+}
+
+bool AStrikesCharacter::CanUseMagic() const
+{
+	// Magic can be used once the cooldown after the last use has passed.
+	return StrikesMagic::CanUse(GetMagicCoreState(), GetServerTime());
+}
+
+bool AStrikesCharacter::CanFireMagic() const
+{
+	return StrikesMagic::CanFire(GetMagicCoreState(), GetMagicRules(), GetServerTime());
+}
+
 void AStrikesCharacter::SetDamageState()
 {
 	// Sets the character to a state where it can be damaged.
-	bCanBeDamaged = true;
+	FStrikesHealthState State = GetHealthCoreState();
+	StrikesHealth::EndInvincibility(State);
+	SetHealthCoreState(State);
 }
 
 void AStrikesCharacter::DamageTimer()
 {
-	// Sets a timer to allow the character to be damaged after a delay.
-	GetWorldTimerManager().SetTimer(
-		MemberTimerHandler, this, &AStrikesCharacter::SetDamageState, 2.f, false
-	);
+	// Keeps the character invincible for a while after being damaged.
+	FStrikesHealthState State = GetHealthCoreState();
+	StrikesHealth::StartInvincibility(State, InvincibilityDuration, GetServerTime());
+	SetHealthCoreState(State);
 }
 
 void AStrikesCharacter::SetMagicValue()
 {
-	// Updates the magic value based on the current timeline position and curve.
+	STRIKES_SCOPE_CYCLE_COUNTER(STAT_StrikesSetMagicValue);
+
+	// Updates the magic value based on the current curve position.
+	FStrikesMagicState State = GetMagicCoreState();
+	StrikesMagic::StoreCurveValue(State, GetMagicRules(), GetServerTime());
+	SetMagicCoreState(State);
+	MarkMagicDirty();
+}
+
+float AStrikesCharacter::SampleMagicCurve(const float From, const float Delta, const double StartTime,
+                                          const double Time) const
+{
+	return StrikesMagic::SampleCurve(GetMagicRules(), From, Delta, StartTime, Time);
+}
+
+float AStrikesCharacter::EvaluateMagicCurve() const
+{
+	return StrikesMagic::Evaluate(GetMagicCoreState(), GetMagicRules(), GetServerTime());
+}
+
+bool AStrikesCharacter::IsMagicCurveDriven() const
+{
+	return StrikesMagic::IsCurveDriven(GetMagicCoreState(), GetMagicRules(), GetServerTime());
+}
+
+bool AStrikesCharacter::IsMagicAnimating() const
+{
+	return StrikesMagic::IsAnimating(GetMagicCoreState(), GetMagicRules(), GetServerTime());
+}
+
+void AStrikesCharacter::PlayMagicCurve()
+{
+	// Start evaluating the curve from now on.
+	FStrikesMagicState State = GetMagicCoreState();
+	if (!StrikesMagic::PlayCurve(State, GetMagicRules(), GetServerTime()))
+	{
+		return;
+	}
+
+	SetMagicCoreState(State);
+	MarkMagicDirty();
 
-	TimeLineValue = MyTimeline.GetPlaybackPosition();
-	CurveFloatValue = PreviousMagic + MagicValue * MagicCurve->GetFloatValue(TimeLineValue);
-	Magic = CurveFloatValue * FullHealth;
-	Magic = FMath::Clamp(Magic, 0.0f, FullMagic);
-	MagicPercentage = CurveFloatValue;
-	MagicPercentage = FMath::Clamp(MagicPercentage, 0.0f, 1.0f);
+	OnMagicChanged.Broadcast(this);
+}
+
+void AStrikesCharacter::StopMagicCurve()
+{
+	// Apply anything that has already happened, then keep the value reached so far.
+	FStrikesMagicState State = GetMagicCoreState();
+	if (StrikesMagic::StopCurve(State, GetMagicRules(), GetServerTime()))
+	{
+		SetMagicCoreState(State);
+		MarkMagicDirty();
+	}
+}
+
+void AStrikesCharacter::SettleMagic()
+{
+	FStrikesMagicState State = GetMagicCoreState();
+	if (StrikesMagic::Settle(State, GetMagicRules(), GetServerTime()))
+	{
+		SetMagicCoreState(State);
+		MarkMagicDirty();
+	}
+}
+
+void AStrikesCharacter::OnOverheatEnded()
+{
+	// The cooldown has passed, so the weapon is no longer overheated.
+	TriggerOverheat(false);
 }
 
 void AStrikesCharacter::SetMagicState()
 {
 	// Sets the character to a state where magic can be used and resets the magic value.
-	bCanUseMagic = true;
-	MagicValue = 0.f;
+	FStrikesMagicState State = GetMagicCoreState();
+	StrikesMagic::ResetCooldown(State, GetMagicRules(), GetServerTime());
+	SetMagicCoreState(State);
+	MarkMagicDirty();
 
 	// Applies the default material to the weapon mesh if available.
 	TriggerOverheat(false);
@@ -245,19 +695,15 @@ void AStrikesCharacter::SetMagicState()
 
 bool AStrikesCharacter::PlayFlash()
 {
-	// Toggles the red flash effect on or off and returns whether the flash was active.
-
-	if (!bRedFlash)
-	{
-		// Early exit if the flash effect is not active
-		return false;
-	}
-
-	// Deactivate the flash effect
+	// Turns the red flash effect off and returns whether it was active.
+	// Clients only see the flash through the replicated bRedFlash.
+	FStrikesHealthState State = GetHealthCoreState();
+	State.bRedFlash |= bRedFlash;
+	const bool bFlash = StrikesHealth::ConsumeFlash(State);
+	SetHealthCoreState(State);
 	bRedFlash = false;
 
-	// Return true indicating the flash was active
-	return true;
+	return bFlash;
 }
 
 
@@ -268,56 +714,121 @@ float AStrikesCharacter::TakeDamage(
 	AActor* DamageCauser
 )
 {
-	// Disables the ability to take damage and triggers a red flash effect.
-	// Updates health based on the damage received and starts a timer to re-enable damage capability.
-	bCanBeDamaged = false;
-	bRedFlash = true;
-	UpdateHealth(-DamageAmount);
-	DamageTimer();
+	STRIKES_SCOPE_CYCLE_COUNTER(STAT_StrikesTakeDamage);
+	STRIKES_COUNT_EVENT(STAT_StrikesDamageEvents, EStrikesFrameEvent::EDamageEvent, 1);
+
+	// Damage during the invincibility window after the last hit is ignored
+	FStrikesHealthState State = GetHealthCoreState();
+	const double Now = GetServerTime();
+	if (!StrikesHealth::IsDamageable(State, Now))
+	{
+		return 0.f;
+	}
+
+	// Triggers a red flash effect, updates health based on the damage received and starts the invincibility window.
+	// Damage is only applied by the server, which owns health.
+	const EStrikesHealthChange Change = StrikesHealth::TakeDamage(State, DamageAmount, InvincibilityDuration, Now);
+	SetHealthCoreState(State);
+
+	// The invincibility window used to be a timer set on every hit
+	STRIKES_COUNT_EVENT(STAT_StrikesTimerOpsAvoided, EStrikesFrameEvent::ETimerOpAvoided, 1);
+
+	// The flash is sent even if health didn't change
+	MarkHealthDirty();
+	NotifyHealthChange(Change);
 
 	return Super::TakeDamage(DamageAmount, DamageEvent, EventInstigator, DamageCauser);
 }
 
 void AStrikesCharacter::UpdateHealth(const float HealthChange)
 {
-	// Modifies the current health by the specified amount and ensures it remains within valid range.
-	// Updates health percentage based on the new health value.
-	Health += HealthChange;
-	Health = FMath::Clamp(Health, 0.0f, FullHealth);
-	PreviousHealth = HealthPercentage;
-	HealthPercentage = Health / FullHealth;
+	STRIKES_SCOPE_CYCLE_COUNTER(STAT_StrikesUpdateHealth);
+
+	// Health is owned by the server; clients receive it through replication.
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	FStrikesHealthState State = GetHealthCoreState();
+	const EStrikesHealthChange Change = StrikesHealth::Apply(State, HealthChange);
+	SetHealthCoreState(State);
+
+	if (Change == EStrikesHealthChange::ENone)
+	{
+		// Nothing changed, so there is nothing to notify or replicate
+		return;
+	}
+
+	MarkHealthDirty();
+	NotifyHealthChange(Change);
+}
+
+void AStrikesCharacter::NotifyHealthChange(const EStrikesHealthChange Change)
+{
+	if (Change == EStrikesHealthChange::ENone)
+	{
+		return;
+	}
+
+	OnHealthChanged.Broadcast(this, GetHealth());
+
+	// Notify listeners once, on the update that takes health down to zero
+	if (Change == EStrikesHealthChange::EDied)
+	{
+		OnDied.Broadcast(this);
+	}
 }
 
 
 void AStrikesCharacter::UpdateMagic()
 {
-	// Updates the magic percentage and initiates a timeline to animate the change.
-	// Sets the magic value to a default of 1 and starts the timeline.
-	PreviousMagic = MagicPercentage;
-	MagicPercentage = Magic / FullMagic;
-	MagicValue = 1.f;
-	MyTimeline.PlayFromStart();
+	// Updates the magic percentage and starts the magic curve to animate the change.
+	FStrikesMagicState State = GetMagicCoreState();
+	const bool bCurveStarted = StrikesMagic::Update(State, GetMagicRules(), GetServerTime());
+	SetMagicCoreState(State);
+	MarkMagicDirty();
+
+	if (bCurveStarted)
+	{
+		OnMagicChanged.Broadcast(this);
+	}
 }
 
 void AStrikesCharacter::SetMagicChange(const float MagicChange)
 {
-	// Disables the ability to use magic and updates the magic value based on the change specified.
-	// Updates the material of the weapon to indicate overheat and starts the timeline for magic change.
-	bCanUseMagic = false;
-	PreviousMagic = MagicPercentage;
-	MagicValue = (MagicChange / FullMagic);
+	// Disables the ability to use magic until the curve animating the change has played.
+	FStrikesMagicState State = GetMagicCoreState();
+	const bool bCurveStarted = StrikesMagic::Change(State, GetMagicRules(), MagicChange, GetServerTime());
+	SetMagicCoreState(State);
+	MarkMagicDirty();
+
+	NotifyMagicChange(bCurveStarted);
+}
 
-	// Pass true or false based on whether it's overheating
+void AStrikesCharacter::NotifyMagicChange(const bool bCurveStarted)
+{
+	// Updates the material of the weapon to indicate overheat; the attribute settle loop reports its end.
 	TriggerOverheat(true);
 
-	// Starts the timeline to animate the change in magic value.
-	MyTimeline.PlayFromStart();
+	// The end of the overheat used to be a timer set on every change.
+	if (OnOverheat.IsBound())
+	{
+		STRIKES_COUNT_EVENT(STAT_StrikesTimerOpsAvoided, EStrikesFrameEvent::ETimerOpAvoided, 1);
+	}
+
+	// Listeners follow the curve animating the change in magic value.
+	if (bCurveStarted)
+	{
+		OnMagicChanged.Broadcast(this);
+	}
 }
 
 
 void AStrikesCharacter::TriggerOverheat(const bool bOverheat)
 {
 	/** Triggers an overheat event and broadcasts it if there are any listeners. */
+	bOverheated = bOverheat;
 	if (OnOverheat.IsBound())
 	{
 		OnOverheat.Broadcast(bOverheat);
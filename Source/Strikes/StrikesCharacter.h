@@ -5,7 +5,10 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "Logging/LogMacros.h"
-#include "Components/TimelineComponent.h"
+#include "StrikesCoreAttributes.h"
+#include "StrikesCoreCurve.h"
+#include "StrikesNetTypes.h"
+#include "StrikesResettable.h"
 #include "StrikesCharacter.generated.h"
 
 class UInputComponent;
@@ -13,14 +16,23 @@ class USkeletalMeshComponent;
 class UCameraComponent;
 class UInputAction;
 class UInputMappingContext;
+class UStrikesAttributeSubsystem;
 struct FInputActionValue;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogTemplateCharacter, Log, All);
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnOverheat, bool, bOverheat);
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnHealthChanged, AStrikesCharacter*, Character, float, NewHealthPercentage);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnCharacterDied, AStrikesCharacter*, Character);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnMagicChanged, AStrikesCharacter*, Character);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnMagicPredictionRejected);
+
 UCLASS(config=Game)
-class AStrikesCharacter : public ACharacter
+class AStrikesCharacter : public ACharacter, public IStrikesResettable
 {
 	GENERATED_BODY()
 
@@ -45,8 +57,8 @@ public:
 
 protected:
 	virtual void BeginPlay();
-
-	virtual void Tick(float DeltaTime) override;
+	virtual void PostInitializeComponents() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 	/** Look Input Action */
@@ -55,106 +67,109 @@ public:
 
 	// Health Properties
 
-	/**
-	 * Total amount of health the character can have.
-	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Health")
-	float FullHealth;
-
-	/**
-	 * Current health of the character.
-	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Health")
-	float Health;
-
-	/**
-	 * Percentage of current health compared to the full health.
-	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Health")
-	float HealthPercentage;
-
-	/**
-	 * Previous value of health before the last update.
-	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Health")
-	float PreviousHealth;
-
 	/**
 	 * Indicates if the screen should flash red (e.g., when taking damage).
+	 * Copy of the flash in the attribute store, replicated to the owning player by MarkHealthDirty.
 	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Health")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category="Health")
 	bool bRedFlash;
 
 	// Magic Properties
 
 	/**
-	 * Total amount of magic the character can have.
+	 * Curve used to modify magic values over time.
 	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Magic")
-	float FullMagic;
+	UCurveFloat* MagicCurve;
+
 
 	/**
-	 * Current amount of magic the character has.
+	 * How long MagicCurve plays after each magic change, in seconds.
+	 * Magic is evaluated from the curve on read, so nothing needs to tick while it plays.
 	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Magic")
-	float Magic;
+	UPROPERTY(EditAnywhere, Category="Magic")
+	float MagicCurveLength;
 
 	/**
-	 * Percentage of current magic compared to the full magic.
+	 * How long the character stays invincible after taking damage, in seconds.
 	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Magic")
-	float MagicPercentage;
+	UPROPERTY(EditAnywhere, Category="Health")
+	float InvincibilityDuration;
 
 	/**
-	 * Previous value of magic before the last update.
+	 * Delay after using magic before it starts regenerating, in seconds.
 	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Magic")
-	float PreviousMagic;
+	UPROPERTY(EditAnywhere, Category="Magic")
+	float MagicRegenDelay;
 
 	/**
-	 * Amount of magic to be used or changed.
+	 * How long a predicted magic spend is shown without an answer from the server before it is dropped, in seconds.
 	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Magic")
-	float MagicValue;
+	UPROPERTY(EditAnywhere, Category="Magic")
+	float MagicPredictionTimeout;
 
 	/**
-	 * Curve used to modify magic values over time.
+	 * Gets the time used for health and magic timestamps: the server's world time, so the timestamps mean the same
+	 * on clients that receive them.
+	 * 
+	 * @return Server world time in seconds.
 	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Magic")
-	UCurveFloat* MagicCurve;
+	double GetServerTime() const;
 
+	/** Server time of the world state this player currently sees, which trails the server by the replication delay */
+	double GetViewTime() const;
 
 	/**
-	 * Timeline for managing magic-related events or animations.
+	 * Checks whether the invincibility window after the last hit has passed.
+	 * 
+	 * @return True if the character can be damaged.
 	 */
-	UPROPERTY(EditAnywhere, Category="Magic")
-	FTimeline MyTimeline;
+	UFUNCTION(BlueprintPure, Category="Health")
+	bool IsDamageable() const;
 
 	/**
-	 * Timer handle for managing time-based events related to magic.
+	 * Checks whether the cooldown after the last magic use has passed.
+	 * 
+	 * @return True if the character can use magic.
 	 */
-	UPROPERTY(EditAnywhere, Category="Magic")
-	FTimerHandle MemberTimerHandler;
+	UFUNCTION(BlueprintPure, Category="Magic")
+	bool CanUseMagic() const;
 
 	/**
-	 * Timer handle for managing magic-specific time-based events.
+	 * Checks whether the weapon can fire a shot: there is magic left. The cooldown doesn't apply; the weapon's
+	 * fire rate paces the shots.
+	 * 
+	 * @return True if the character can fire.
 	 */
-	UPROPERTY(EditAnywhere, Category="Magic")
-	FTimerHandle MagicTimerHandler;
+	bool CanFireMagic() const;
 
-	// Internal Properties
+	/** Gets the character's health from the attribute store, or full health outside of game worlds */
+	FStrikesHealthState GetHealthCoreState() const;
 
-	// Value of the curve float for current magic status.
-	float CurveFloatValue;
+	/** Gets the character's magic from the attribute store, or full magic outside of game worlds */
+	FStrikesMagicState GetMagicCoreState() const;
 
-	// Current value of the timeline for magic events.	
-	float TimeLineValue;
+	/** Gets the magic tuning of this character for the StrikesMagic rules */
+	FStrikesMagicRules GetMagicRules() const;
 
-	// Indicates if the character can be damaged.
-	bool bCanBeDamaged;
+	/** Called by UStrikesAttributeSubsystem after its per-frame loop changed this character's magic */
+	void OnMagicSettled();
 
-	// Indicates if the character can use magic.
-	bool bCanUseMagic;
+	/**
+	 * Called by UStrikesDamageZoneSubsystem after its attribute store pass damaged this character. Notifies the health
+	 * change, then sends the engine's damage events as TakeDamage does.
+	 *
+	 * @param bDied Whether the damage took health down to zero.
+	 * @param DamageAmount Damage the pass applied.
+	 * @param DamageEvent Damage event, with the damage type.
+	 * @param EventInstigator Controller responsible for the damage, if any.
+	 * @param DamageCauser Actor that caused the damage.
+	 */
+	void OnStoreDamage(bool bDied, float DamageAmount, const FDamageEvent& DamageEvent, AController* EventInstigator,
+	                   AActor* DamageCauser);
+
+	/** Index of the character's attributes in the attribute store, or INDEX_NONE outside of game worlds */
+	int32 GetAttributeIndex() const;
 
 
 	// Health Functions
@@ -169,6 +184,7 @@ public:
 
 	/**
 	 * Gets the current health as a formatted text.
+	 * Formats a new string on every call; widgets should use the cached text from UStrikesHUDViewModel.
 	 * 
 	 * @return Formatted health text.
 	 */
@@ -184,8 +200,25 @@ public:
 	UFUNCTION(BlueprintPure, Category="Magic")
 	float GetMagic() const;
 
+	/**
+	 * Gets the current amount of magic, evaluated from the magic curve if it is playing.
+	 * 
+	 * @return Current magic amount.
+	 */
+	UFUNCTION(BlueprintPure, Category="Magic")
+	float GetMagicAmount() const;
+
+	/**
+	 * Gets the total amount of magic the character can have.
+	 * 
+	 * @return Full magic amount.
+	 */
+	UFUNCTION(BlueprintPure, Category="Magic")
+	float GetFullMagic() const;
+
 	/**
 	 * Gets the current magic amount as a formatted text.
+	 * Formats a new string on every call; widgets should use the cached text from UStrikesHUDViewModel.
 	 * 
 	 * @return Formatted magic text.
 	 */
@@ -193,7 +226,7 @@ public:
 	FText GetMagicIntText() const;
 
 	/**
-	 * Function called on a timer to handle damage-related events.
+	 * Starts the invincibility window that follows taking damage.
 	 */
 	UFUNCTION()
 	void DamageTimer();
@@ -205,7 +238,7 @@ public:
 	void SetDamageState();
 
 	/**
-	 * Sets the amount of magic the character can use.
+	 * Sets the amount of magic the character can use from the current position on the magic curve.
 	 */
 	UFUNCTION()
 	void SetMagicValue();
@@ -239,17 +272,11 @@ public:
 	bool PlayFlash();
 
 	/**
-	 * Default material for the weapon.
+	 * Default material for the weapon; overheat tints a parameter of it.
 	 */
 	UPROPERTY(EditAnywhere, Category="Magic")
 	UMaterialInterface* GunDefaultMaterial;
 
-	/**
-	 * Material applied to the weapon when it overheats.
-	 */
-	UPROPERTY(EditAnywhere, Category="Magic")
-	UMaterialInterface* GunOverheatMaterial;
-
 	virtual float TakeDamage(
 		float DamageAmount,
 		FDamageEvent const& DamageEvent,
@@ -258,25 +285,171 @@ public:
 	) override;
 
 	/**
-	 * Updates the health of the character based on the given change.
+	 * Updates the health of the character based on the given change. Only has an effect on the server.
 	 * 
 	 * @param HealthChange The amount by which to change the health.
 	 */
 	UFUNCTION(BlueprintCallable, Category="Health")
 	void UpdateHealth(float HealthChange);
 
+	/**
+	 * Sets health and magic to full and clears any pending damage or magic cooldowns.
+	 */
+	void InitializeAttributes();
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/** Called for movement input, and by AStrikesBotController */
+	void Move(const FInputActionValue& Value);
+
+	/** Called for looking input, and by AStrikesBotController */
+	void Look(const FInputActionValue& Value);
+
+	/**
+	 * Asks the server to pull the trigger of the equipped weapon.
+	 *
+	 * @param ShooterViewTime Server time of the world state the player saw, for lag compensation.
+	 * @param PredictionKey Key of the magic spend the client predicted for the shot, or 0.
+	 */
+	UFUNCTION(Server, Reliable)
+	void ServerStartFire(double ShooterViewTime, uint16 PredictionKey);
+
+	/**
+	 * Asks the server to release the trigger of the equipped weapon.
+	 */
+	UFUNCTION(Server, Reliable)
+	void ServerStopFire();
+
+	// IStrikesResettable interface
+	virtual void RestoreInitialState() override;
+	// End of IStrikesResettable interface
+
+	/**
+	 * Starts playing the magic curve from the beginning.
+	 */
+	void PlayMagicCurve();
+
+	/**
+	 * Stops the magic curve, keeping the magic value reached so far. Does not trigger SetMagicState.
+	 */
+	void StopMagicCurve();
+
+	/**
+	 * Applies magic transitions whose time has passed: the end of the magic curve and the start of regeneration.
+	 */
+	void SettleMagic();
+
+	/**
+	 * Called when the attribute store settles the end of the magic cooldown, to notify OnOverheat listeners.
+	 */
+	void OnOverheatEnded();
+
+	/**
+	 * Samples the magic curve.
+	 * 
+	 * @param From Magic percentage at the start of the curve.
+	 * @param Delta Change in magic percentage scaled by the curve.
+	 * @param StartTime World time the curve started.
+	 * @param Time World time to sample at.
+	 * @return Unclamped magic percentage.
+	 */
+	float SampleMagicCurve(float From, float Delta, double StartTime, double Time) const;
+
+	/**
+	 * Evaluates the magic curve at the current time, including regeneration that has started but not been applied yet.
+	 * 
+	 * @return Unclamped magic percentage at the current curve position.
+	 */
+	float EvaluateMagicCurve() const;
+
+	/**
+	 * Checks whether the magic value is currently driven by the magic curve.
+	 * 
+	 * @return True if GetMagic must evaluate the curve.
+	 */
+	bool IsMagicCurveDriven() const;
+
+	/**
+	 * Checks whether GetMagic changes over time right now, because the magic curve or regeneration is playing.
+	 * 
+	 * @return True while the magic value is animating.
+	 */
+	bool IsMagicAnimating() const;
+
 	/**
 	 * Resets and initializes the magic-related timers and updates.
 	 * Stops any ongoing magic timeline, clears and sets up a new magic timer, and updates the magic value.
 	 */
 	void InitializeMagicTimers();
 
+	/**
+	 * Applies the magic spend of a shot on the owning client before the server confirms it.
+	 * The state is kept until replicated magic acknowledges the returned key, and shown again over older updates.
+	 *
+	 * @return Key to send to the server with the shot.
+	 */
+	uint16 PredictMagicSpend();
+
+	/**
+	 * Tells the owning client that the server has processed its prediction, in the next magic update.
+	 *
+	 * @param PredictionKey Key the client sent with the shot; 0 is ignored.
+	 * @param bFired Whether the predicted shot was fired, or dropped without firing.
+	 */
+	void AcknowledgePrediction(uint16 PredictionKey, bool bFired);
+
 protected:
-	/** Called for movement input */
-	void Move(const FInputActionValue& Value);
+	/** Quantized health sent to every client, filled by MarkHealthDirty */
+	UPROPERTY(ReplicatedUsing=OnRep_NetHealth)
+	FStrikesNetHealth NetHealth;
 
-	/** Called for looking input */
-	void Look(const FInputActionValue& Value);
+	/** Quantized magic state sent to the owning client, filled by MarkMagicDirty */
+	UPROPERTY(ReplicatedUsing=OnRep_NetMagic)
+	FStrikesNetMagic NetMagic;
+
+	/** Applies the replicated health and notifies listeners */
+	UFUNCTION()
+	void OnRep_NetHealth(const FStrikesNetHealth& OldNetHealth);
+
+	/** Applies the replicated magic state, notifies listeners and mirrors the server's overheat window */
+	UFUNCTION()
+	void OnRep_NetMagic();
+
+	/** Copies health into NetHealth and marks it dirty for push-model replication */
+	void MarkHealthDirty();
+
+	/** Copies the magic state into NetMagic and marks it dirty for push-model replication */
+	void MarkMagicDirty();
+
+	/** Stores health computed by the StrikesHealth rules in the attribute store */
+	void SetHealthCoreState(const FStrikesHealthState& State);
+
+	/** Stores magic computed by the StrikesMagic rules in the attribute store */
+	void SetMagicCoreState(const FStrikesMagicState& State);
+
+	/** Broadcasts OnHealthChanged, and OnDied if health dropped to zero */
+	void NotifyHealthChange(EStrikesHealthChange Change);
+
+	/** Starts the overheat window that follows a magic change, and broadcasts OnMagicChanged if a curve started */
+	void NotifyMagicChange(bool bCurveStarted);
+
+	/** Copies the magic state into a replicated snapshot */
+	void WriteMagicState(FStrikesNetMagic& OutState) const;
+
+	/** Replaces the magic state with a replicated snapshot */
+	void ReadMagicState(const FStrikesNetMagic& NetState);
+
+	/** Predicted magic spends the server hasn't acknowledged yet, oldest first */
+	TArray<FStrikesMagicPrediction> PendingMagicPredictions;
+
+	/** Last prediction key issued by this client */
+	uint16 LastPredictionKey = 0;
+
+	/** Last prediction key of the owning client processed by the server */
+	uint16 AckedPredictionKey = 0;
+
+	/** Whether the shot of AckedPredictionKey was fired */
+	bool bAckedPredictionFired = false;
 
 protected:
 	// APawn interface
@@ -295,4 +468,42 @@ public:
 
 	// Function to trigger overheat event
 	void TriggerOverheat(bool bOverheat);
+
+	// Delegate broadcast from UpdateHealth whenever the health percentage changes
+	UPROPERTY(BlueprintAssignable, Category="Events")
+	FOnHealthChanged OnHealthChanged;
+
+	// Delegate broadcast from UpdateHealth when health drops to zero
+	UPROPERTY(BlueprintAssignable, Category="Events")
+	FOnCharacterDied OnDied;
+
+	// Delegate broadcast when the magic curve starts animating a change, or magic is reset
+	UPROPERTY(BlueprintAssignable, Category="Events")
+	FOnMagicChanged OnMagicChanged;
+
+	// Delegate broadcast on the owning client when the server didn't fire a shot it predicted
+	UPROPERTY(BlueprintAssignable, Category="Events")
+	FOnMagicPredictionRejected OnMagicPredictionRejected;
+
+private:
+	// Whether OnOverheat last reported an overheat, so its end is reported once
+	bool bOverheated = false;
+
+	// Transform the character began play with, restored on soft reset
+	FTransform InitialTransform;
+
+	// Control rotation the character began play with, restored on soft reset
+	FRotator InitialControlRotation;
+
+	// Subsystem storing the character's health and magic, and the handle to them
+	UPROPERTY(Transient)
+	UStrikesAttributeSubsystem* AttributeSubsystem;
+	FStrikesAttributeHandle AttributeHandle;
+
+	// Gets MagicCurve baked for the magic rules, or null if there is no curve
+	const FStrikesCoreCurve* GetBakedMagicCurve() const;
+
+	// MagicCurve sampled for the magic rules, and the curve it was baked from
+	mutable FStrikesCoreCurve BakedMagicCurve;
+	mutable const UCurveFloat* BakedMagicCurveSource = nullptr;
 };
@@ -0,0 +1,203 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrikesDamageZones.h"
+#include "CampFire.h"
+#include "StrikesAttributes.h"
+#include "StrikesCharacter.h"
+#include "StrikesCoreDamage.h"
+#include "StrikesStats.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+
+bool UStrikesDamageZoneSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// Only game worlds apply damage
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UStrikesDamageZoneSubsystem::IsTickable() const
+{
+	// Nothing to do while nobody stands in a zone
+	return Victims.Num() > 0;
+}
+
+TStatId UStrikesDamageZoneSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UStrikesDamageZoneSubsystem, STATGROUP_Tickables);
+}
+
+void UStrikesDamageZoneSubsystem::AddVictim(ACampFire* Zone, AActor* Victim, const FHitResult& Hit)
+{
+	FStrikesDamageZoneVictim* Existing = Victims.FindByPredicate([Zone, Victim](const FStrikesDamageZoneVictim& Entry)
+	{
+		return Entry.Zone == Zone && Entry.Victim == Victim;
+	});
+
+	if (Existing != nullptr)
+	{
+		// Another component of an actor that is already inside
+		++Existing->OverlapCount;
+		return;
+	}
+
+	// Damage immediately, then every damage interval
+	FStrikesDamageZoneVictim& Entry = Victims.AddDefaulted_GetRef();
+	Entry.Zone = Zone;
+	Entry.Victim = Victim;
+	Entry.Hit = Hit;
+	Entry.NextDamageTime = GetWorld()->GetTimeSeconds();
+	Entry.OverlapCount = 1;
+
+	NextPassTime = FMath::Min(NextPassTime, Entry.NextDamageTime);
+}
+
+void UStrikesDamageZoneSubsystem::RemoveVictim(ACampFire* Zone, AActor* Victim)
+{
+	const int32 Index = Victims.IndexOfByPredicate([Zone, Victim](const FStrikesDamageZoneVictim& Entry)
+	{
+		return Entry.Zone == Zone && Entry.Victim == Victim;
+	});
+
+	if (Index != INDEX_NONE && --Victims[Index].OverlapCount <= 0)
+	{
+		Victims.RemoveAtSwap(Index);
+	}
+}
+
+int32 UStrikesDamageZoneSubsystem::GetNumActiveZones() const
+{
+	// Few zones are active at once, so a linear scan beats hashing
+	TArray<const ACampFire*, TInlineAllocator<16>> Zones;
+	for (const FStrikesDamageZoneVictim& Entry : Victims)
+	{
+		Zones.AddUnique(Entry.Zone.Get());
+	}
+	Zones.Remove(nullptr);
+	return Zones.Num();
+}
+
+void UStrikesDamageZoneSubsystem::RemoveZone(ACampFire* Zone)
+{
+	Victims.RemoveAllSwap([Zone](const FStrikesDamageZoneVictim& Entry)
+	{
+		return Entry.Zone == Zone;
+	});
+}
+
+void UStrikesDamageZoneSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (Now < NextPassTime)
+	{
+		return;
+	}
+
+	NextPassTime = TNumericLimits<double>::Max();
+
+	// Health timestamps are in server time, as AStrikesCharacter::GetServerTime reads them
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	const double ServerNow = GameState != nullptr ? GameState->GetServerWorldTimeSeconds() : Now;
+
+	UStrikesAttributeSubsystem* Attributes = GetWorld()->GetSubsystem<UStrikesAttributeSubsystem>();
+	FStrikesAttributeStore* Store = Attributes != nullptr ? &Attributes->GetStore() : nullptr;
+
+	// Collect the due ticks first: applying damage can end the round and reset the zones
+	DueDamage.Reset();
+	StoreDamage.Reset();
+	CombatantDamage.Reset();
+	CombatantDamage.SetNumZeroed(Store != nullptr ? Store->Num() : 0);
+
+	// The store pass starts one invincibility window for everyone it damages
+	float PassInvincibility = -1.f;
+
+	for (int32 Index = Victims.Num() - 1; Index >= 0; --Index)
+	{
+		FStrikesDamageZoneVictim& Entry = Victims[Index];
+
+		const ACampFire* Zone = Entry.Zone.Get();
+		if (Zone == nullptr || !Entry.Victim.IsValid())
+		{
+			// Either side was destroyed
+			Victims.RemoveAtSwap(Index);
+			continue;
+		}
+
+		// Catch up on every tick that came due since the last pass, like a looping timer would
+		const int32 DueTicks = StrikesDamage::ConsumeDueTicks(Entry.NextDamageTime, Zone->DamageInterval, Now);
+		NextPassTime = FMath::Min(NextPassTime, Entry.NextDamageTime);
+		if (DueTicks == 0)
+		{
+			continue;
+		}
+
+		// Characters with another invincibility duration than the pass fall back to TakeDamage
+		AStrikesCharacter* Character = Cast<AStrikesCharacter>(Entry.Victim.Get());
+		const int32 CombatantIndex = Character != nullptr && Store != nullptr && !Zone->bSendDamageEvents &&
+			(PassInvincibility < 0.f || PassInvincibility == Character->InvincibilityDuration)
+			? Character->GetAttributeIndex()
+			: INDEX_NONE;
+
+		if (CombatantIndex == INDEX_NONE)
+		{
+			for (int32 Tick = 0; Tick < DueTicks; ++Tick)
+			{
+				DueDamage.Add(Entry);
+			}
+			continue;
+		}
+
+		// Invincible characters are skipped, and only the first tick lands: it starts the invincibility window the
+		// others would fall in
+		if (Zone->DamageAmount > 0.f && CombatantDamage[CombatantIndex] == 0.f &&
+			Store->IsDamageable(CombatantIndex, ServerNow))
+		{
+			CombatantDamage[CombatantIndex] = Zone->DamageAmount;
+			PassInvincibility = Character->InvincibilityDuration;
+
+			FStoreDamage& Damage = StoreDamage.AddDefaulted_GetRef();
+			Damage.Character = Character;
+			Damage.Zone = Entry.Zone;
+			Damage.DamageEvent = Zone->MakeFireDamageEvent(Entry.Hit);
+			Damage.Index = CombatantIndex;
+		}
+	}
+
+	if (StoreDamage.Num() > 0)
+	{
+		STRIKES_SCOPE_CYCLE_COUNTER(STAT_StrikesCampFireDamage);
+		STRIKES_COUNT_EVENT(STAT_StrikesDamageEvents, EStrikesFrameEvent::EDamageEvent, StoreDamage.Num());
+
+		// The invincibility window used to be a timer set on every hit
+		STRIKES_COUNT_EVENT(STAT_StrikesTimerOpsAvoided, EStrikesFrameEvent::ETimerOpAvoided, StoreDamage.Num());
+
+		Died.Reset();
+		Store->TakeDamage(CombatantDamage, PassInvincibility, ServerNow, Died);
+
+		// Resolve deaths before notifying anyone: a death can end the round, which moves store entries around
+		for (FStoreDamage& Damage : StoreDamage)
+		{
+			Damage.bDied = Died.Contains(Damage.Index);
+		}
+
+		for (const FStoreDamage& Damage : StoreDamage)
+		{
+			if (AStrikesCharacter* Character = Damage.Character.Get())
+			{
+				Character->OnStoreDamage(Damage.bDied, Damage.DamageEvent.Damage, Damage.DamageEvent, nullptr,
+				                         Damage.Zone.Get());
+			}
+		}
+	}
+
+	for (const FStrikesDamageZoneVictim& Damage : DueDamage)
+	{
+		ACampFire* Zone = Damage.Zone.Get();
+		AActor* Victim = Damage.Victim.Get();
+		if (Zone != nullptr && Victim != nullptr)
+		{
+			Zone->ApplyFireDamage(Victim, Damage.Hit);
+		}
+	}
+}
@@ -0,0 +1,118 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DamageEvents.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "StrikesDamageZones.generated.h"
+
+class ACampFire;
+class AStrikesCharacter;
+
+/**
+ * An actor standing inside a damage zone.
+ */
+USTRUCT()
+struct FStrikesDamageZoneVictim
+{
+	GENERATED_BODY()
+
+	/** Zone applying the damage */
+	TWeakObjectPtr<ACampFire> Zone;
+
+	/** Actor receiving the damage */
+	TWeakObjectPtr<AActor> Victim;
+
+	/** Hit result from the overlap that started the damage */
+	FHitResult Hit;
+
+	/** World time the next damage tick is due */
+	double NextDamageTime = 0.0;
+
+	/** Number of the victim's components currently overlapping the zone */
+	int32 OverlapCount = 0;
+};
+
+/**
+ * Applies periodic damage for every damage zone in the world from a single tick.
+ * Tracks each (zone, victim) pair on its own schedule, so a zone can damage any number of actors
+ * and an actor can stand in any number of zones without per-zone timers. Characters take the damage that came due
+ * in one attribute store pass, and get the engine's damage events afterwards; other actors, and zones with
+ * bSendDamageEvents, go through AActor::TakeDamage.
+ */
+UCLASS()
+class STRIKES_API UStrikesDamageZoneSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Starts damaging an actor that entered a zone. The first tick is applied on the next pass.
+	 *
+	 * @param Zone The damage zone.
+	 * @param Victim The actor that entered the zone.
+	 * @param Hit Hit result from the overlap, passed on to the damage event.
+	 */
+	void AddVictim(ACampFire* Zone, AActor* Victim, const FHitResult& Hit);
+
+	/**
+	 * Stops damaging an actor once none of its components overlap the zone anymore.
+	 *
+	 * @param Zone The damage zone.
+	 * @param Victim The actor that left the zone.
+	 */
+	void RemoveVictim(ACampFire* Zone, AActor* Victim);
+
+	/**
+	 * Stops damaging every actor inside a zone.
+	 *
+	 * @param Zone The damage zone.
+	 */
+	void RemoveZone(ACampFire* Zone);
+
+	/** Number of (zone, victim) pairs currently being damaged */
+	UFUNCTION(BlueprintPure, Category="Damage")
+	int32 GetNumVictims() const { return Victims.Num(); }
+
+	/** Number of zones currently damaging at least one actor */
+	int32 GetNumActiveZones() const;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	// End of FTickableGameObject interface
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** A character damaged by the attribute store pass */
+	struct FStoreDamage
+	{
+		TWeakObjectPtr<AStrikesCharacter> Character;
+		TWeakObjectPtr<ACampFire> Zone;
+		FPointDamageEvent DamageEvent;
+		int32 Index = INDEX_NONE;
+		bool bDied = false;
+	};
+
+	/** Every actor currently inside a zone */
+	TArray<FStrikesDamageZoneVictim> Victims;
+
+	/** Due ticks applied through the engine's damage events by the last pass, kept to reuse the allocation */
+	TArray<FStrikesDamageZoneVictim> DueDamage;
+
+	/** Damage of the last store pass for each combatant, by attribute store index */
+	TArray<float> CombatantDamage;
+
+	/** Characters damaged by the last store pass */
+	TArray<FStoreDamage> StoreDamage;
+
+	/** Combatants that died in the last store pass */
+	TArray<int32> Died;
+
+	/** Earliest NextDamageTime across all victims, so frames without due damage return early */
+	double NextPassTime = 0.0;
+};
@@ -5,9 +5,55 @@
 #include "AsyncTreeDifferences.h"
 #include "StrikesCharacter.h"
 #include "StrikesHUD.h"
+#include "StrikesLevelReset.h"
+#include "StrikesReplicationGraph.h"
+#include "StrikesStats.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
 #include "Kismet/GameplayStatics.h"
+#include "TimerManager.h"
 #include "UObject/ConstructorHelpers.h"
 
+namespace
+{
+	float GBandwidthLogInterval = 0.f;
+	FAutoConsoleVariableRef CVarBandwidthLogInterval(
+		TEXT("Strikes.Net.BandwidthLogInterval"),
+		GBandwidthLogInterval,
+		TEXT("If greater than zero, the server logs every client's bandwidth at this interval in seconds."),
+		ECVF_Default);
+
+	/** Logs the bandwidth of every client connection of the world's net driver, and the server cost per connection. */
+	void LogClientBandwidth(const UWorld* World)
+	{
+		const UNetDriver* NetDriver = World != nullptr ? World->GetNetDriver() : nullptr;
+		if (NetDriver == nullptr)
+		{
+			return;
+		}
+
+		// Only the replication graph measures itself; compare with `stat net` when running without it
+		if (const UStrikesReplicationGraph* Graph = Cast<UStrikesReplicationGraph>(NetDriver->GetReplicationDriver()))
+		{
+			const int32 NumConnections = FMath::Max(NetDriver->ClientConnections.Num(), 1);
+			UE_LOG(LogTemplateCharacter, Log, TEXT("Net: replicate %.3f ms/frame, %.4f ms/frame per connection"),
+			       Graph->GetAverageReplicateMs(), Graph->GetAverageReplicateMs() / NumConnections);
+		}
+
+		for (const UNetConnection* Connection : NetDriver->ClientConnections)
+		{
+			UE_LOG(LogTemplateCharacter, Log, TEXT("Net: %s out %d B/s in %d B/s"),
+			       *GetNameSafe(Connection->PlayerController), Connection->OutBytesPerSecond,
+			       Connection->InBytesPerSecond);
+		}
+	}
+
+	FAutoConsoleCommandWithWorld CmdLogBandwidth(
+		TEXT("Strikes.Net.LogBandwidth"),
+		TEXT("Logs every client's bandwidth once."),
+		FConsoleCommandWithWorldDelegate::CreateStatic(&LogClientBandwidth));
+}
+
 AStrikesGameMode::AStrikesGameMode()
 	: Super()
 {
@@ -18,6 +64,9 @@ AStrikesGameMode::AStrikesGameMode()
 
 	// Set the HUD class to use the custom AStrikesHUD class for the game's user interface.
 	HUDClass = AStrikesHUD::StaticClass();
+
+	// Game state changes are driven by character events, so there is nothing to do per frame
+	PrimaryActorTick.bCanEverTick = false;
 }
 
 void AStrikesGameMode::BeginPlay()
@@ -27,21 +76,32 @@ void AStrikesGameMode::BeginPlay()
 	// Set the initial game state to playing
 	SetCurrentState(EGamePlayState::EPlaying);
 
-	// Get the player character and cast it to our custom character class
-	MyCharacter = Cast<AStrikesCharacter>(UGameplayStatics::GetPlayerPawn(this, 0));
+	// Report per-client bandwidth for headless multi-client runs
+	if (GBandwidthLogInterval > 0.f && GetNetMode() != NM_Standalone)
+	{
+		FTimerHandle BandwidthLogTimerHandle;
+		STRIKES_COUNT_EVENT(STAT_StrikesTimerOps, EStrikesFrameEvent::ETimerOp, 1);
+		GetWorldTimerManager().SetTimer(BandwidthLogTimerHandle, FTimerDelegate::CreateWeakLambda(this, [this]()
+		{
+			LogClientBandwidth(GetWorld());
+		}), GBandwidthLogInterval, true);
+	}
 }
 
-void AStrikesGameMode::Tick(const float DeltaTime)
+void AStrikesGameMode::RegisterCharacter(AStrikesCharacter* Character)
 {
-	Super::Tick(DeltaTime);
+	if (Character)
+	{
+		Character->OnDied.AddUniqueDynamic(this, &AStrikesGameMode::OnCharacterDied);
+	}
+}
 
-	if (MyCharacter)
+void AStrikesGameMode::OnCharacterDied(AStrikesCharacter* Character)
+{
+	// Only a player's death ends the game, once until the restart
+	if (Character && Character->IsPlayerControlled() && CurrentState != EGamePlayState::EGameOver)
 	{
-		// Check if the player's health is nearly zero and set the game state to Game Over if true
-		if (FMath::IsNearlyZero(MyCharacter->GetHealth(), 0.001f))
-		{
-			SetCurrentState(EGamePlayState::EGameOver);
-		}
+		SetCurrentState(EGamePlayState::EGameOver);
 	}
 }
 
@@ -56,7 +116,7 @@ void AStrikesGameMode::SetCurrentState(EGamePlayState NewState)
 	HandleNewState(NewState);
 }
 
-void AStrikesGameMode::HandleNewState(const EGamePlayState NewState) const
+void AStrikesGameMode::HandleNewState(const EGamePlayState NewState)
 {
 	switch (NewState)
 	{
@@ -68,8 +128,31 @@ void AStrikesGameMode::HandleNewState(const EGamePlayState NewState) const
 		}
 	case EGamePlayState::EGameOver:
 		{
-			// Reload the current level to restart the game
-			UGameplayStatics::OpenLevel(this, FName(*GetWorld()->GetName()), false);
+			UStrikesLevelResetSubsystem* ResetSubsystem = GetWorld()->GetSubsystem<UStrikesLevelResetSubsystem>();
+			if (ResetSubsystem && ResetSubsystem->bSoftReset)
+			{
+				// Restore the world in place and keep playing. Game over is reached from inside the dying character's
+				// damage and death callbacks, so wait for the next tick instead of restoring it under its own feet
+				STRIKES_COUNT_EVENT(STAT_StrikesTimerOps, EStrikesFrameEvent::ETimerOp, 1);
+				GetWorldTimerManager().SetTimerForNextTick(FTimerDelegate::CreateWeakLambda(this, [this]()
+				{
+					if (UStrikesLevelResetSubsystem* Subsystem = GetWorld()->GetSubsystem<UStrikesLevelResetSubsystem>())
+					{
+						Subsystem->ResetLevel();
+					}
+					SetCurrentState(EGamePlayState::EPlaying);
+				}));
+			}
+			else if (ResetSubsystem)
+			{
+				// Reload the current level to restart the game
+				ResetSubsystem->ReloadLevel();
+			}
+			else
+			{
+				// Reload the current level to restart the game
+				UGameplayStatics::OpenLevel(this, FName(*GetWorld()->GetName()), false);
+			}
 			break;
 		}
 	case EGamePlayState::EUnknown:
@@ -39,20 +39,17 @@ public:
 
 	/**
 	 * Called when the game starts or when spawned.
-	 * Sets the initial game state and retrieves the player character.
+	 * Sets the initial game state.
 	 */
 	virtual void BeginPlay() override;
 
 	/**
-	 * Called every frame.
-	 * Checks the health of the player character and updates the game state if necessary.
-	 * 
-	 * @param DeltaTime The time elapsed since the last frame.
+	 * Starts following the health of a character so the game state can react to its death.
+	 * Called by every AStrikesCharacter when it begins play.
+	 *
+	 * @param Character The character to follow.
 	 */
-	virtual void Tick(float DeltaTime) override;
-
-	/** Pointer to the player character. */
-	AStrikesCharacter* MyCharacter;
+	void RegisterCharacter(AStrikesCharacter* Character);
 
 	/**
 	 * Gets the current state of the game.
@@ -78,5 +75,14 @@ private:
 	 * 
 	 * @param NewState The new game play state to handle.
 	 */
-	void HandleNewState(EGamePlayState NewState) const;
+	void HandleNewState(EGamePlayState NewState);
+
+	/**
+	 * Called when a registered character's health drops to zero.
+	 * Ends the game if the character was controlled by a player.
+	 *
+	 * @param Character The character that died.
+	 */
+	UFUNCTION()
+	void OnCharacterDied(AStrikesCharacter* Character);
 };
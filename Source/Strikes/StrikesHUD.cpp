@@ -2,25 +2,38 @@
 
 
 #include "StrikesHUD.h"
+#include "StrikesCharacter.h"
+#include "StrikesHealthWidget.h"
+#include "StrikesHUDViewModel.h"
+#include "StrikesStats.h"
 
 #include "Blueprint/UserWidget.h"
 
 AStrikesHUD::AStrikesHUD()
 {
-	// Find and set the HUD widget class from the specified path
-	static ConstructorHelpers::FClassFinder<UUserWidget> HealthBarObj(TEXT("/Game/FirstPerson/UI/WBP_Health_UI"));
-	HUDWidgetClass = HealthBarObj.Class;
+	// Use the native HUD widget unless config points to another class
+	HUDWidgetClass = UStrikesHealthWidget::StaticClass();
 }
 
 void AStrikesHUD::BeginPlay()
 {
 	Super::BeginPlay();
 
+	STRIKES_SCOPE_CYCLE_COUNTER(STAT_StrikesHUDCreate);
+
+	// Create the view-model before the widget so the widget can bind to it on construct
+	ViewModel = NewObject<UStrikesHUDViewModel>(this);
+	if (PlayerOwner != nullptr)
+	{
+		PlayerOwner->OnPossessedPawnChanged.AddUniqueDynamic(this, &AStrikesHUD::OnPossessedPawnChanged);
+		ViewModel->SetCharacter(Cast<AStrikesCharacter>(PlayerOwner->GetPawn()));
+	}
+
 	// Create and display the HUD widget if the class is valid
-	if (HUDWidgetClass != nullptr)
+	if (const TSubclassOf<UUserWidget> WidgetClass = HUDWidgetClass.LoadSynchronous())
 	{
-		// Create an instance of the HUD widget using the class found in the constructor
-		CurrentWidget = CreateWidget<UUserWidget>(GetWorld(), HUDWidgetClass);
+		// Create an instance of the HUD widget for the owning player
+		CurrentWidget = CreateWidget<UUserWidget>(PlayerOwner, WidgetClass);
 
 		// If the widget was created successfully, add it to the viewport to display it on screen
 		if (CurrentWidget)
@@ -29,3 +42,8 @@ void AStrikesHUD::BeginPlay()
 		}
 	}
 }
+
+void AStrikesHUD::OnPossessedPawnChanged(APawn* OldPawn, APawn* NewPawn)
+{
+	ViewModel->SetCharacter(Cast<AStrikesCharacter>(NewPawn));
+}
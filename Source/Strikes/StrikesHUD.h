@@ -6,10 +6,12 @@
 #include "GameFramework/HUD.h"
 #include "StrikesHUD.generated.h"
 
+class UStrikesHUDViewModel;
+
 /**
  * 
  */
-UCLASS()
+UCLASS(config=Game)
 class STRIKES_API AStrikesHUD : public AHUD
 {
 	GENERATED_BODY()
@@ -22,18 +24,30 @@ public:
 
 	virtual void BeginPlay() override;
 
+	/** Returns the view-model the HUD widget binds its events to */
+	UFUNCTION(BlueprintPure, Category="Health")
+	UStrikesHUDViewModel* GetViewModel() const { return ViewModel; }
+
 private:
+	/** Follows the newly possessed pawn */
+	UFUNCTION()
+	void OnPossessedPawnChanged(APawn* OldPawn, APawn* NewPawn);
+
 	// TODO: Impelement simple Crosshair
 	// /** Crosshair asset pointer */
 	// UTexture2D* CrosshairTex;
 
-	// Class of the HUD widget to be used. This should be set in the editor or through code.
+	// Class of the HUD widget to be used. Defaults to the native UStrikesHealthWidget and can be set in config.
 	// The widget class must derive from UUserWidget and is used to create instances of the HUD widget.
-	UPROPERTY(EditAnywhere, Category="Health")
-	TSubclassOf<UUserWidget> HUDWidgetClass;
+	UPROPERTY(Config, EditAnywhere, Category="Health")
+	TSoftClassPtr<UUserWidget> HUDWidgetClass;
 
 	// Instance of the HUD widget currently being displayed.
 	// This is the actual widget that will be added to the viewport.
 	UPROPERTY(EditAnywhere, Category="Health")
 	UUserWidget* CurrentWidget;
+
+	// Caches the health and magic values shown by the widget and pushes changes to it.
+	UPROPERTY(Transient)
+	UStrikesHUDViewModel* ViewModel;
 };
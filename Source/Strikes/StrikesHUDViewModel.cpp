@@ -0,0 +1,137 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrikesHUDViewModel.h"
+#include "StrikesCharacter.h"
+#include "StrikesStats.h"
+
+void UStrikesHUDViewModel::SetCharacter(AStrikesCharacter* InCharacter)
+{
+	if (AStrikesCharacter* OldCharacter = Character.Get())
+	{
+		OldCharacter->OnHealthChanged.RemoveDynamic(this, &UStrikesHUDViewModel::HandleHealthChanged);
+		OldCharacter->OnMagicChanged.RemoveDynamic(this, &UStrikesHUDViewModel::HandleMagicChanged);
+	}
+
+	Character = InCharacter;
+	bMagicAnimating = false;
+
+	if (InCharacter != nullptr)
+	{
+		InCharacter->OnHealthChanged.AddUniqueDynamic(this, &UStrikesHUDViewModel::HandleHealthChanged);
+		InCharacter->OnMagicChanged.AddUniqueDynamic(this, &UStrikesHUDViewModel::HandleMagicChanged);
+
+		// Push the starting values so the widget doesn't have to read them
+		RefreshHealth(true);
+		RefreshMagic(true);
+	}
+}
+
+void UStrikesHUDViewModel::BeginDestroy()
+{
+	SetCharacter(nullptr);
+
+	Super::BeginDestroy();
+}
+
+void UStrikesHUDViewModel::HandleHealthChanged(AStrikesCharacter* InCharacter, float NewHealthPercentage)
+{
+	// Health only goes down when the character is damaged
+	const bool bDamaged = NewHealthPercentage < HealthPercentage;
+
+	RefreshHealth(false);
+
+	if (bDamaged)
+	{
+		OnFlash.Broadcast();
+	}
+}
+
+void UStrikesHUDViewModel::HandleMagicChanged(AStrikesCharacter* InCharacter)
+{
+	// The curve may have started animating, Tick picks it up from here
+	RefreshMagic(false);
+}
+
+void UStrikesHUDViewModel::RefreshHealth(const bool bForce)
+{
+	const AStrikesCharacter* Shown = Character.Get();
+	if (Shown == nullptr)
+	{
+		return;
+	}
+
+	const float NewPercentage = Shown->GetHealth();
+	if (!bForce && NewPercentage == HealthPercentage)
+	{
+		return;
+	}
+	HealthPercentage = NewPercentage;
+
+	// Same rounding as AStrikesCharacter::GetHealthIntText, but only format when the number shown changes
+	const int32 NewNumber = FMath::RoundHalfFromZero(HealthPercentage * 100);
+	if (bForce || NewNumber != HealthNumber)
+	{
+		HealthNumber = NewNumber;
+		HealthText = FText::FromString(FString::Printf(TEXT("%d%%"), HealthNumber));
+	}
+
+	StrikesFrameEvents::Add(EStrikesFrameEvent::EHUDUpdate);
+	OnHealthUpdated.Broadcast(HealthPercentage, HealthText);
+}
+
+void UStrikesHUDViewModel::RefreshMagic(const bool bForce)
+{
+	const AStrikesCharacter* Shown = Character.Get();
+	if (Shown == nullptr)
+	{
+		return;
+	}
+
+	const float NewPercentage = Shown->GetMagic();
+	if (!bForce && NewPercentage == MagicPercentage)
+	{
+		return;
+	}
+	MagicPercentage = NewPercentage;
+
+	// Same rounding as AStrikesCharacter::GetMagicIntText, but only format when the numbers shown change
+	const int32 NewNumber = FMath::RoundHalfFromZero(MagicPercentage * 100);
+	const int32 NewFullNumber = static_cast<int32>(Shown->GetFullMagic());
+	if (bForce || NewNumber != MagicNumber || NewFullNumber != FullMagicNumber)
+	{
+		MagicNumber = NewNumber;
+		FullMagicNumber = NewFullNumber;
+		MagicText = FText::FromString(FString::Printf(TEXT("%d/%d"), MagicNumber, FullMagicNumber));
+	}
+
+	StrikesFrameEvents::Add(EStrikesFrameEvent::EHUDUpdate);
+	OnMagicUpdated.Broadcast(MagicPercentage, MagicText);
+}
+
+void UStrikesHUDViewModel::Tick(float DeltaTime)
+{
+	bMagicAnimating = Character.IsValid() && Character->IsMagicAnimating();
+	RefreshMagic(false);
+}
+
+bool UStrikesHUDViewModel::IsTickable() const
+{
+	// Only tick while the magic curve moves the value, plus one more tick to pick up where it stopped
+	const AStrikesCharacter* Shown = Character.Get();
+	return Shown != nullptr && (bMagicAnimating || Shown->IsMagicAnimating());
+}
+
+ETickableTickType UStrikesHUDViewModel::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+UWorld* UStrikesHUDViewModel::GetTickableGameObjectWorld() const
+{
+	return Character.IsValid() ? Character->GetWorld() : nullptr;
+}
+
+TStatId UStrikesHUDViewModel::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UStrikesHUDViewModel, STATGROUP_Tickables);
+}
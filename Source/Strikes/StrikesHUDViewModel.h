@@ -0,0 +1,102 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "UObject/Object.h"
+#include "StrikesHUDViewModel.generated.h"
+
+class AStrikesCharacter;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnHUDHealthUpdated, float, HealthPercentage, const FText&, HealthText);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnHUDMagicUpdated, float, MagicPercentage, const FText&, MagicText);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnHUDFlash);
+
+/**
+ * Caches the values shown by the health HUD and pushes them to the widget when they change.
+ * Text is only formatted again when the displayed number changes, and the view-model only ticks while the
+ * magic curve is animating, so an idle HUD costs no bindings and no string allocations per frame.
+ */
+UCLASS(BlueprintType)
+class STRIKES_API UStrikesHUDViewModel : public UObject, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	/** Broadcast when the health percentage changes */
+	UPROPERTY(BlueprintAssignable, Category="Health")
+	FOnHUDHealthUpdated OnHealthUpdated;
+
+	/** Broadcast when the magic percentage changes */
+	UPROPERTY(BlueprintAssignable, Category="Magic")
+	FOnHUDMagicUpdated OnMagicUpdated;
+
+	/** Broadcast when the character takes damage and the screen should flash */
+	UPROPERTY(BlueprintAssignable, Category="Health")
+	FOnHUDFlash OnFlash;
+
+	/**
+	 * Starts following a character, or stops following if null. Broadcasts the current values.
+	 * 
+	 * @param InCharacter Character whose health and magic are shown.
+	 */
+	UFUNCTION(BlueprintCallable, Category="HUD")
+	void SetCharacter(AStrikesCharacter* InCharacter);
+
+	/** Returns the cached health percentage */
+	UFUNCTION(BlueprintPure, Category="Health")
+	float GetHealthPercentage() const { return HealthPercentage; }
+
+	/** Returns the cached health text (e.g. "75%") */
+	UFUNCTION(BlueprintPure, Category="Health")
+	const FText& GetHealthText() const { return HealthText; }
+
+	/** Returns the cached magic percentage */
+	UFUNCTION(BlueprintPure, Category="Magic")
+	float GetMagicPercentage() const { return MagicPercentage; }
+
+	/** Returns the cached magic text (e.g. "30/100") */
+	UFUNCTION(BlueprintPure, Category="Magic")
+	const FText& GetMagicText() const { return MagicText; }
+
+	virtual void BeginDestroy() override;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	virtual TStatId GetStatId() const override;
+	// End of FTickableGameObject interface
+
+private:
+	UFUNCTION()
+	void HandleHealthChanged(AStrikesCharacter* InCharacter, float NewHealthPercentage);
+
+	UFUNCTION()
+	void HandleMagicChanged(AStrikesCharacter* InCharacter);
+
+	/** Reads health from the character and broadcasts if it changed */
+	void RefreshHealth(bool bForce);
+
+	/** Reads magic from the character and broadcasts if it changed */
+	void RefreshMagic(bool bForce);
+
+	/** Character being shown */
+	TWeakObjectPtr<AStrikesCharacter> Character;
+
+	float HealthPercentage = -1.f;
+	int32 HealthNumber = INDEX_NONE;
+	FText HealthText;
+
+	float MagicPercentage = -1.f;
+	int32 MagicNumber = INDEX_NONE;
+	int32 FullMagicNumber = INDEX_NONE;
+	FText MagicText;
+
+	/** Set while the magic curve was animating on the last tick, so the final value is picked up too */
+	bool bMagicAnimating = false;
+};
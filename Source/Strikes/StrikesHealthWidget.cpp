@@ -0,0 +1,262 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrikesHealthWidget.h"
+#include "StrikesHUD.h"
+#include "StrikesHUDViewModel.h"
+#include "StrikesStats.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/Image.h"
+#include "Components/InvalidationBox.h"
+#include "Components/Overlay.h"
+#include "Components/OverlaySlot.h"
+#include "Components/ProgressBar.h"
+#include "Components/RetainerBox.h"
+#include "Components/TextBlock.h"
+#include "Components/VerticalBox.h"
+#include "Components/VerticalBoxSlot.h"
+#include "TimerManager.h"
+#include "Widgets/SCompoundWidget.h"
+
+/**
+ * Wraps the HUD's Slate tree to time its paint and prepass.
+ * Nothing is recorded while the content is cached by an invalidation box or retainer.
+ */
+class SStrikesHUDStatScope : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SStrikesHUDStatScope)
+		{
+		}
+
+		SLATE_DEFAULT_SLOT(FArguments, Content)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs)
+	{
+		// Needed for CustomPrepass to be called before the children are prepassed
+		bHasCustomPrepass = true;
+
+		ChildSlot
+		[
+			InArgs._Content.Widget
+		];
+	}
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+	                      FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle,
+	                      bool bParentEnabled) const override
+	{
+		SCOPE_CYCLE_COUNTER(STAT_StrikesHUDPaint);
+
+		return SCompoundWidget::OnPaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle,
+		                                bParentEnabled);
+	}
+
+protected:
+	virtual bool CustomPrepass(float LayoutScaleMultiplier) override
+	{
+		PrepassStartCycles = FPlatformTime::Cycles();
+
+		return true;
+	}
+
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override
+	{
+		// Children have been prepassed by now, so this closes the span opened in CustomPrepass
+		const FVector2D DesiredSize = SCompoundWidget::ComputeDesiredSize(LayoutScaleMultiplier);
+		SET_CYCLE_COUNTER(STAT_StrikesHUDPrepass, FPlatformTime::Cycles() - PrepassStartCycles);
+
+		return DesiredSize;
+	}
+
+private:
+	uint32 PrepassStartCycles = 0;
+};
+
+void UStrikesHealthWidget::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	BuildDefaultTree();
+
+	if (StaticPanel != nullptr)
+	{
+		StaticPanel->SetCanCache(true);
+	}
+
+	if (TextRetainer != nullptr)
+	{
+		const bool bCapTextRedraw = TextRedrawPhases > 1;
+		TextRetainer->SetRetainRendering(bCapTextRedraw);
+		if (bCapTextRedraw)
+		{
+			TextRetainer->SetRenderingPhase(0, TextRedrawPhases);
+		}
+	}
+
+	if (FlashImage != nullptr)
+	{
+		FlashImage->SetVisibility(ESlateVisibility::Collapsed);
+	}
+}
+
+void UStrikesHealthWidget::BuildDefaultTree()
+{
+	// A Blueprint subclass provides its own layout
+	if (WidgetTree == nullptr || WidgetTree->RootWidget != nullptr)
+	{
+		return;
+	}
+
+	UOverlay* Root = WidgetTree->ConstructWidget<UOverlay>(UOverlay::StaticClass(), TEXT("Root"));
+	WidgetTree->RootWidget = Root;
+
+	FlashImage = WidgetTree->ConstructWidget<UImage>(UImage::StaticClass(), TEXT("FlashImage"));
+	FlashImage->SetColorAndOpacity(FLinearColor(1.f, 0.f, 0.f, 0.3f));
+	UOverlaySlot* FlashSlot = Root->AddChildToOverlay(FlashImage);
+	FlashSlot->SetHorizontalAlignment(HAlign_Fill);
+	FlashSlot->SetVerticalAlignment(VAlign_Fill);
+
+	UVerticalBox* Bars = WidgetTree->ConstructWidget<UVerticalBox>(UVerticalBox::StaticClass(), TEXT("Bars"));
+	HealthBar = WidgetTree->ConstructWidget<UProgressBar>(UProgressBar::StaticClass(), TEXT("HealthBar"));
+	HealthBar->SetFillColorAndOpacity(FLinearColor::Red);
+	Bars->AddChildToVerticalBox(HealthBar)->SetPadding(FMargin(0.f, 0.f, 0.f, 4.f));
+	MagicBar = WidgetTree->ConstructWidget<UProgressBar>(UProgressBar::StaticClass(), TEXT("MagicBar"));
+	MagicBar->SetFillColorAndOpacity(FLinearColor::Blue);
+	Bars->AddChildToVerticalBox(MagicBar);
+
+	StaticPanel = WidgetTree->ConstructWidget<UInvalidationBox>(UInvalidationBox::StaticClass(), TEXT("StaticPanel"));
+	StaticPanel->AddChild(Bars);
+	UOverlaySlot* BarsSlot = Root->AddChildToOverlay(StaticPanel);
+	BarsSlot->SetHorizontalAlignment(HAlign_Left);
+	BarsSlot->SetVerticalAlignment(VAlign_Bottom);
+	BarsSlot->SetPadding(FMargin(40.f, 0.f, 0.f, 40.f));
+
+	UVerticalBox* Texts = WidgetTree->ConstructWidget<UVerticalBox>(UVerticalBox::StaticClass(), TEXT("Texts"));
+	HealthText = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass(), TEXT("HealthText"));
+	Texts->AddChildToVerticalBox(HealthText);
+	MagicText = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass(), TEXT("MagicText"));
+	Texts->AddChildToVerticalBox(MagicText);
+
+	TextRetainer = WidgetTree->ConstructWidget<URetainerBox>(URetainerBox::StaticClass(), TEXT("TextRetainer"));
+	TextRetainer->AddChild(Texts);
+	UOverlaySlot* TextsSlot = Root->AddChildToOverlay(TextRetainer);
+	TextsSlot->SetHorizontalAlignment(HAlign_Left);
+	TextsSlot->SetVerticalAlignment(VAlign_Bottom);
+	TextsSlot->SetPadding(FMargin(40.f, 0.f, 0.f, 80.f));
+}
+
+TSharedRef<SWidget> UStrikesHealthWidget::RebuildWidget()
+{
+	return SNew(SStrikesHUDStatScope)
+		[
+			Super::RebuildWidget()
+		];
+}
+
+void UStrikesHealthWidget::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	// Follow the HUD's view-model unless one was set explicitly
+	if (ViewModel == nullptr)
+	{
+		const APlayerController* PlayerController = GetOwningPlayer();
+		if (const AStrikesHUD* HUD = PlayerController ? PlayerController->GetHUD<AStrikesHUD>() : nullptr)
+		{
+			SetViewModel(HUD->GetViewModel());
+		}
+	}
+}
+
+void UStrikesHealthWidget::NativeDestruct()
+{
+	SetViewModel(nullptr);
+
+	Super::NativeDestruct();
+}
+
+void UStrikesHealthWidget::SetViewModel(UStrikesHUDViewModel* InViewModel)
+{
+	if (ViewModel != nullptr)
+	{
+		ViewModel->OnHealthUpdated.RemoveDynamic(this, &UStrikesHealthWidget::HandleHealthUpdated);
+		ViewModel->OnMagicUpdated.RemoveDynamic(this, &UStrikesHealthWidget::HandleMagicUpdated);
+		ViewModel->OnFlash.RemoveDynamic(this, &UStrikesHealthWidget::HandleFlash);
+	}
+
+	ViewModel = InViewModel;
+
+	if (ViewModel != nullptr)
+	{
+		ViewModel->OnHealthUpdated.AddUniqueDynamic(this, &UStrikesHealthWidget::HandleHealthUpdated);
+		ViewModel->OnMagicUpdated.AddUniqueDynamic(this, &UStrikesHealthWidget::HandleMagicUpdated);
+		ViewModel->OnFlash.AddUniqueDynamic(this, &UStrikesHealthWidget::HandleFlash);
+
+		// The view-model may have pushed its values before we were listening
+		HandleHealthUpdated(ViewModel->GetHealthPercentage(), ViewModel->GetHealthText());
+		HandleMagicUpdated(ViewModel->GetMagicPercentage(), ViewModel->GetMagicText());
+	}
+}
+
+void UStrikesHealthWidget::UpdateBar(UProgressBar* Bar, float& ShownPercentage, const float NewPercentage) const
+{
+	if (Bar == nullptr)
+	{
+		return;
+	}
+
+	// Always reach the ends exactly, otherwise skip changes too small to see
+	const bool bAtEnd = (NewPercentage <= 0.f || NewPercentage >= 1.f) && NewPercentage != ShownPercentage;
+	if (bAtEnd || FMath::Abs(NewPercentage - ShownPercentage) >= BarInvalidationThreshold)
+	{
+		ShownPercentage = NewPercentage;
+		Bar->SetPercent(NewPercentage);
+	}
+}
+
+void UStrikesHealthWidget::HandleHealthUpdated(const float HealthPercentage, const FText& InHealthText)
+{
+	UpdateBar(HealthBar, ShownHealthPercentage, HealthPercentage);
+
+	// The view-model keeps the same text instance until the number shown changes
+	if (HealthText != nullptr && !HealthText->GetText().IdenticalTo(InHealthText))
+	{
+		HealthText->SetText(InHealthText);
+	}
+}
+
+void UStrikesHealthWidget::HandleMagicUpdated(const float MagicPercentage, const FText& InMagicText)
+{
+	UpdateBar(MagicBar, ShownMagicPercentage, MagicPercentage);
+
+	if (MagicText != nullptr && !MagicText->GetText().IdenticalTo(InMagicText))
+	{
+		MagicText->SetText(InMagicText);
+	}
+}
+
+void UStrikesHealthWidget::HandleFlash()
+{
+	if (FlashAnimation != nullptr)
+	{
+		PlayAnimation(FlashAnimation);
+		return;
+	}
+
+	if (FlashImage != nullptr)
+	{
+		FlashImage->SetVisibility(ESlateVisibility::HitTestInvisible);
+		STRIKES_COUNT_EVENT(STAT_StrikesTimerOps, EStrikesFrameEvent::ETimerOp, 1);
+		GetWorld()->GetTimerManager().SetTimer(FlashTimerHandle, this, &UStrikesHealthWidget::EndFlash, FlashDuration,
+		                                       false);
+	}
+}
+
+void UStrikesHealthWidget::EndFlash()
+{
+	if (FlashImage != nullptr)
+	{
+		FlashImage->SetVisibility(ESlateVisibility::Collapsed);
+	}
+}
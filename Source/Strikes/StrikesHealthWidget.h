@@ -0,0 +1,110 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "StrikesHealthWidget.generated.h"
+
+class UImage;
+class UInvalidationBox;
+class UProgressBar;
+class URetainerBox;
+class UStrikesHUDViewModel;
+class UTextBlock;
+class UWidgetAnimation;
+
+/**
+ * Native health, magic and damage flash HUD.
+ * Widgets can be bound from a Blueprint subclass; any that are missing are built in code, so the class works on its own.
+ * The bars sit behind an invalidation box and are only invalidated when they move by a visible amount, and the text can
+ * be redrawn at a capped rate through a retainer box. Paint and prepass time are reported in `stat Strikes`.
+ */
+UCLASS(config=Game)
+class STRIKES_API UStrikesHealthWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	/** Smallest change in a bar's percentage that is worth repainting, about one pixel on a 500px bar */
+	UPROPERTY(Config, EditAnywhere, Category="HUD")
+	float BarInvalidationThreshold = 0.002f;
+
+	/** Redraw the text only every Nth frame through the retainer box; 0 or 1 draws it every frame */
+	UPROPERTY(Config, EditAnywhere, Category="HUD")
+	int32 TextRedrawPhases = 0;
+
+	/**
+	 * Starts showing the values of a view-model.
+	 * 
+	 * @param InViewModel View-model to follow, usually the one owned by AStrikesHUD.
+	 */
+	UFUNCTION(BlueprintCallable, Category="HUD")
+	void SetViewModel(UStrikesHUDViewModel* InViewModel);
+
+protected:
+	UPROPERTY(BlueprintReadOnly, Category="HUD", meta=(BindWidgetOptional))
+	UProgressBar* HealthBar;
+
+	UPROPERTY(BlueprintReadOnly, Category="HUD", meta=(BindWidgetOptional))
+	UProgressBar* MagicBar;
+
+	UPROPERTY(BlueprintReadOnly, Category="HUD", meta=(BindWidgetOptional))
+	UTextBlock* HealthText;
+
+	UPROPERTY(BlueprintReadOnly, Category="HUD", meta=(BindWidgetOptional))
+	UTextBlock* MagicText;
+
+	/** Full screen image shown while the damage flash plays */
+	UPROPERTY(BlueprintReadOnly, Category="HUD", meta=(BindWidgetOptional))
+	UImage* FlashImage;
+
+	/** Caches the bars and the rest of the static layout */
+	UPROPERTY(BlueprintReadOnly, Category="HUD", meta=(BindWidgetOptional))
+	UInvalidationBox* StaticPanel;
+
+	/** Holds the text so it can be redrawn at a capped rate */
+	UPROPERTY(BlueprintReadOnly, Category="HUD", meta=(BindWidgetOptional))
+	URetainerBox* TextRetainer;
+
+	/** Played on damage; without it FlashImage is shown for FlashDuration */
+	UPROPERTY(Transient, BlueprintReadOnly, Category="HUD", meta=(BindWidgetAnimOptional))
+	UWidgetAnimation* FlashAnimation;
+
+	/** How long FlashImage is shown when there is no FlashAnimation, in seconds */
+	UPROPERTY(EditAnywhere, Category="HUD")
+	float FlashDuration = 0.2f;
+
+	virtual void NativeOnInitialized() override;
+	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
+	virtual TSharedRef<SWidget> RebuildWidget() override;
+
+private:
+	UFUNCTION()
+	void HandleHealthUpdated(float HealthPercentage, const FText& InHealthText);
+
+	UFUNCTION()
+	void HandleMagicUpdated(float MagicPercentage, const FText& InMagicText);
+
+	UFUNCTION()
+	void HandleFlash();
+
+	/** Hides FlashImage once the flash is over */
+	void EndFlash();
+
+	/** Builds the default layout when no Blueprint subclass provides one */
+	void BuildDefaultTree();
+
+	/** Sets a bar's percentage if it moved by at least BarInvalidationThreshold */
+	void UpdateBar(UProgressBar* Bar, float& ShownPercentage, float NewPercentage) const;
+
+	UPROPERTY(Transient)
+	UStrikesHUDViewModel* ViewModel;
+
+	/** Percentages currently drawn by the bars */
+	float ShownHealthPercentage = -1.f;
+	float ShownMagicPercentage = -1.f;
+
+	FTimerHandle FlashTimerHandle;
+};
@@ -0,0 +1,108 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrikesHitscan.h"
+#include "StrikesLagCompensation.h"
+#include "StrikesProjectile.h"
+#include "StrikesStats.h"
+#include "Engine/World.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+
+bool UStrikesHitscanSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// Only game worlds fire weapons
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UStrikesHitscanSubsystem::IsTickable() const
+{
+	// Nothing to trace while no shot is queued
+	return PendingShots.Num() > 0;
+}
+
+TStatId UStrikesHitscanSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UStrikesHitscanSubsystem, STATGROUP_Tickables);
+}
+
+void UStrikesHitscanSubsystem::QueueShot(const TSubclassOf<AStrikesProjectile> ProjectileClass, const FVector& Start,
+                                         const FVector& Direction, AActor* Instigator, const double RewindTime)
+{
+	if (ProjectileClass == nullptr)
+	{
+		return;
+	}
+
+	// The shot reaches as far and pushes as hard as the projectile it replaces
+	const AStrikesProjectile* Defaults = ProjectileClass->GetDefaultObject<AStrikesProjectile>();
+	const float Speed = Defaults->GetProjectileMovement()->InitialSpeed;
+	const float Range = MaxRange > 0.f ? MaxRange : Speed * Defaults->InitialLifeSpan;
+
+	FStrikesHitscanShot& Shot = PendingShots.AddDefaulted_GetRef();
+	Shot.Start = Start;
+	Shot.End = Start + Direction * Range;
+	Shot.Velocity = Direction * Speed;
+	Shot.Instigator = Instigator;
+	Shot.RewindTime = RewindTime;
+}
+
+void UStrikesHitscanSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!bCollisionParamsCached)
+	{
+		AStrikesProjectile::GetCollisionChannelAndResponse(Channel, ResponseParams);
+		bCollisionParamsCached = true;
+	}
+
+	UWorld* const World = GetWorld();
+	UStrikesLagCompensationSubsystem* LagCompensation = World->GetSubsystem<UStrikesLagCompensationSubsystem>();
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(StrikesHitscan), false);
+
+	// Swap the queue out first: impulses can trigger gameplay that fires again
+	Swap(TracingShots, PendingShots);
+	NumShotsLastTick = TracingShots.Num();
+	INC_DWORD_STAT_BY(STAT_StrikesHitscanTraces, TracingShots.Num());
+
+	// Serial loop of blocking traces, so every hit is applied in the frame the shot was fired
+	for (const FStrikesHitscanShot& Shot : TracingShots)
+	{
+		QueryParams.ClearIgnoredActors();
+		QueryParams.AddIgnoredActor(Shot.Instigator.Get());
+
+		FHitResult Hit;
+		if (Shot.RewindTime >= 0.0 && LagCompensation != nullptr)
+		{
+			// Test characters where the shooter saw them; the world is traced as usual
+			FVector CharacterHitLocation;
+			if (AStrikesCharacter* Target = LagCompensation->ResolveShot(
+				Shot.Start, Shot.End, Shot.RewindTime, Shot.Instigator.Get(), Channel, ResponseParams, Hit,
+				CharacterHitLocation))
+			{
+				LagCompensation->ApplyRewoundHit(Target, Shot.Instigator.Get(), CharacterHitLocation,
+				                                 Shot.Velocity.GetSafeNormal());
+				continue;
+			}
+
+			if (!Hit.bBlockingHit)
+			{
+				continue;
+			}
+		}
+		else if (!World->LineTraceSingleByChannel(Hit, Shot.Start, Shot.End, Channel, QueryParams, ResponseParams))
+		{
+			continue;
+		}
+
+		// Same rule as AStrikesProjectile::OnHit: only physics bodies are pushed
+		UPrimitiveComponent* OtherComp = Hit.GetComponent();
+		if (Hit.GetActor() != nullptr && OtherComp != nullptr && OtherComp->IsSimulatingPhysics())
+		{
+			OtherComp->AddImpulseAtLocation(Shot.Velocity * 100.0f, Hit.Location);
+			INC_DWORD_STAT(STAT_StrikesHits);
+		}
+	}
+
+	// Both arrays keep their allocations for the next frames
+	TracingShots.Reset();
+}
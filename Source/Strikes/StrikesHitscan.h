@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "StrikesHitscan.generated.h"
+
+class AStrikesProjectile;
+
+/**
+ * A hitscan shot waiting for its trace.
+ */
+struct FStrikesHitscanShot
+{
+	/** Muzzle location */
+	FVector Start;
+
+	/** End of the trace */
+	FVector End;
+
+	/** Velocity the equivalent projectile would have had, used for the impulse on physics bodies */
+	FVector Velocity;
+
+	/** Actor that fired, ignored by the trace */
+	TWeakObjectPtr<AActor> Instigator;
+
+	/** Server time to rewind characters to, or negative to test them where they are */
+	double RewindTime = -1.0;
+};
+
+/**
+ * Resolves weapon shots instantly with line traces instead of simulating projectiles.
+ * Shots from every weapon are queued during the frame, then traced one after another in a single loop on the
+ * "Projectile" channel, pushing physics bodies the same way AStrikesProjectile::OnHit does. Each trace is a blocking
+ * scene query; the queue only saves the per-shot overhead of the weapon, not queries.
+ */
+UCLASS(config=Game)
+class STRIKES_API UStrikesHitscanSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Length of a hitscan trace in uu; 0 uses the distance the projectile class would fly in its lifetime */
+	UPROPERTY(Config, EditAnywhere, Category="Projectile")
+	float MaxRange = 0.f;
+
+	/**
+	 * Queues a hitscan shot for this frame's trace loop.
+	 *
+	 * @param ProjectileClass Projectile the shot stands in for; its defaults give speed and range.
+	 * @param Start Muzzle location.
+	 * @param Direction Direction of the shot.
+	 * @param Instigator Actor that fired, ignored by the trace.
+	 * @param RewindTime Server time the shooter saw the targets at, for lag compensation; negative to skip it.
+	 */
+	void QueueShot(TSubclassOf<AStrikesProjectile> ProjectileClass, const FVector& Start, const FVector& Direction,
+	               AActor* Instigator, double RewindTime = -1.0);
+
+	/** Number of shots traced by the last tick */
+	UFUNCTION(BlueprintPure, Category="Projectile")
+	int32 GetNumShotsLastTick() const { return NumShotsLastTick; }
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	// End of FTickableGameObject interface
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Shots queued since the last tick */
+	TArray<FStrikesHitscanShot> PendingShots;
+
+	/** Shots being traced by the current tick */
+	TArray<FStrikesHitscanShot> TracingShots;
+
+	/** Number of shots traced by the last tick */
+	int32 NumShotsLastTick = 0;
+
+	/** Collision settings of the "Projectile" profile, read on first use */
+	ECollisionChannel Channel = ECC_GameTraceChannel1;
+	FCollisionResponseParams ResponseParams;
+	bool bCollisionParamsCached = false;
+};
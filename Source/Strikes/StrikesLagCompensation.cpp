@@ -0,0 +1,332 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrikesLagCompensation.h"
+#include "StrikesCharacter.h"
+#include "StrikesStats.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogStrikesLagComp, Log, All);
+
+namespace
+{
+	/**
+	 * Tests a segment against an upright capsule.
+	 *
+	 * @param OutDistance Distance along the segment where it enters the capsule.
+	 * @return True if the segment touches the capsule.
+	 */
+	bool SegmentHitsCapsule(const FVector& Start, const FVector& End, const FVector& Center, const float Radius,
+	                        const float HalfHeight, float& OutDistance)
+	{
+		const FVector AxisOffset(0.f, 0.f, FMath::Max(HalfHeight - Radius, 0.f));
+
+		FVector OnSegment, OnAxis;
+		FMath::SegmentDistToSegmentSafe(Start, End, Center - AxisOffset, Center + AxisOffset, OnSegment, OnAxis);
+
+		const double DistSquared = FVector::DistSquared(OnSegment, OnAxis);
+		if (DistSquared > FMath::Square(Radius))
+		{
+			return false;
+		}
+
+		// Step back from the closest point to the surface; exact for the caps, close enough for the sides
+		const float Entry = static_cast<float>(FMath::Sqrt(FMath::Square(Radius) - DistSquared));
+		OutDistance = FMath::Max(static_cast<float>(FVector::Dist(Start, OnSegment)) - Entry, 0.f);
+		return true;
+	}
+}
+
+void FStrikesHitboxHistory::Record(const double Time, const FVector& Location)
+{
+	if (Count > 0 && Time <= GetNewestTime())
+	{
+		// Several records in one frame keep the last one
+		Locations[ToSlot(Count - 1)] = Location;
+		return;
+	}
+
+	int32 Slot;
+	if (Count < Capacity)
+	{
+		Slot = ToSlot(Count);
+		++Count;
+	}
+	else
+	{
+		// Full: the oldest sample makes room
+		Slot = Head;
+		Head = (Head + 1) & (Capacity - 1);
+	}
+
+	Times[Slot] = Time;
+	Locations[Slot] = Location;
+}
+
+bool FStrikesHitboxHistory::Sample(const double Time, FVector& OutLocation) const
+{
+	if (Count == 0)
+	{
+		return false;
+	}
+
+	if (Time <= GetOldestTime())
+	{
+		OutLocation = Locations[Head];
+		return true;
+	}
+
+	if (Time >= GetNewestTime())
+	{
+		OutLocation = Locations[ToSlot(Count - 1)];
+		return true;
+	}
+
+	// Binary search for the first sample after Time; timestamps only grow from the oldest sample on
+	int32 Low = 1;
+	int32 High = Count - 1;
+	while (Low < High)
+	{
+		const int32 Mid = (Low + High) / 2;
+		if (Times[ToSlot(Mid)] > Time)
+		{
+			High = Mid;
+		}
+		else
+		{
+			Low = Mid + 1;
+		}
+	}
+
+	const int32 After = ToSlot(Low);
+	const int32 Before = ToSlot(Low - 1);
+	const double Span = Times[After] - Times[Before];
+	const double Alpha = Span > 0.0 ? (Time - Times[Before]) / Span : 1.0;
+
+	OutLocation = FMath::Lerp(Locations[Before], Locations[After], Alpha);
+	return true;
+}
+
+bool UStrikesLagCompensationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// Only game worlds have shots to validate
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UStrikesLagCompensationSubsystem::IsEnabled() const
+{
+	// Clients never validate shots, and a standalone game has no latency to hide
+	const UWorld* World = GetWorld();
+	return MaxRewindTime > 0.f && World != nullptr &&
+		World->GetNetMode() != NM_Client && World->GetNetMode() != NM_Standalone;
+}
+
+bool UStrikesLagCompensationSubsystem::IsTickable() const
+{
+	return IsEnabled();
+}
+
+TStatId UStrikesLagCompensationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UStrikesLagCompensationSubsystem, STATGROUP_Tickables);
+}
+
+double UStrikesLagCompensationSubsystem::ClampRewindTime(const double Time) const
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	return FMath::Clamp(Time, Now - MaxRewindTime, Now);
+}
+
+const FStrikesHitboxHistory* UStrikesLagCompensationSubsystem::FindHistory(const AStrikesCharacter* Character) const
+{
+	return Histories.Find(Character);
+}
+
+void UStrikesLagCompensationSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Drop the histories of characters that are gone
+	for (auto It = Histories.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// Tickables run after the actors, so this is where everyone ended up this frame
+	const double Now = GetWorld()->GetTimeSeconds();
+	for (TActorIterator<AStrikesCharacter> It(GetWorld()); It; ++It)
+	{
+		const AStrikesCharacter* Character = *It;
+		const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+
+		FStrikesHitboxHistory& History = Histories.FindOrAdd(*It);
+		History.Radius = Capsule->GetScaledCapsuleRadius();
+		History.HalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+		History.Record(Now, Capsule->GetComponentLocation());
+	}
+}
+
+AStrikesCharacter* UStrikesLagCompensationSubsystem::TraceRewound(const FVector& Start, const FVector& End,
+                                                                   const double Time, const AActor* Instigator,
+                                                                   FVector& OutLocation) const
+{
+	AStrikesCharacter* Closest = nullptr;
+	float ClosestDistance = TNumericLimits<float>::Max();
+
+	for (const TPair<TWeakObjectPtr<AStrikesCharacter>, FStrikesHitboxHistory>& Pair : Histories)
+	{
+		AStrikesCharacter* Character = Pair.Key.Get();
+		if (Character == nullptr || Character == Instigator)
+		{
+			continue;
+		}
+
+		FVector Center;
+		float Distance;
+		if (Pair.Value.Sample(Time, Center) &&
+			SegmentHitsCapsule(Start, End, Center, Pair.Value.Radius, Pair.Value.HalfHeight, Distance) &&
+			Distance < ClosestDistance)
+		{
+			Closest = Character;
+			ClosestDistance = Distance;
+		}
+	}
+
+	if (Closest != nullptr)
+	{
+		OutLocation = Start + (End - Start).GetSafeNormal() * ClosestDistance;
+	}
+	return Closest;
+}
+
+AStrikesCharacter* UStrikesLagCompensationSubsystem::ResolveShot(const FVector& Start, const FVector& End,
+                                                                  const double Time, AActor* Instigator,
+                                                                  const ECollisionChannel Channel,
+                                                                  const FCollisionResponseParams& ResponseParams,
+                                                                  FHitResult& OutWorldHit, FVector& OutLocation) const
+{
+	// Characters are tested where they were, so their current capsules must not block the world trace
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(StrikesLagCompensation), false, Instigator);
+	for (const TPair<TWeakObjectPtr<AStrikesCharacter>, FStrikesHitboxHistory>& Pair : Histories)
+	{
+		if (const AStrikesCharacter* Character = Pair.Key.Get())
+		{
+			QueryParams.AddIgnoredActor(Character);
+		}
+	}
+
+	OutWorldHit = FHitResult();
+	const bool bWorldHit = GetWorld()->LineTraceSingleByChannel(OutWorldHit, Start, End, Channel, QueryParams,
+	                                                            ResponseParams);
+
+	// A character behind a wall can't be hit
+	AStrikesCharacter* Target = TraceRewound(Start, bWorldHit ? OutWorldHit.Location : End, Time, Instigator,
+	                                         OutLocation);
+	if (Target != nullptr)
+	{
+		OutWorldHit = FHitResult();
+	}
+	return Target;
+}
+
+void UStrikesLagCompensationSubsystem::ApplyRewoundHit(AStrikesCharacter* Target, AActor* Instigator,
+                                                       const FVector& Location, const FVector& Direction)
+{
+	UE_LOG(LogStrikesLagComp, Verbose, TEXT("Rewound hit on %s by %s"), *GetNameSafe(Target), *GetNameSafe(Instigator));
+	INC_DWORD_STAT(STAT_StrikesHits);
+
+	if (CharacterHitDamage > 0.f && Target->IsDamageable())
+	{
+		FHitResult Hit;
+		Hit.Location = Location;
+		Hit.ImpactPoint = Location;
+		UGameplayStatics::ApplyPointDamage(Target, CharacterHitDamage, Direction, Hit,
+		                                   Instigator != nullptr ? Instigator->GetInstigatorController() : nullptr,
+		                                   Instigator, nullptr);
+	}
+
+	OnRewoundHit.Broadcast(Target, Instigator, Location);
+}
+
+namespace
+{
+	/**
+	 * Checks the ring buffer and the rewound traces against a target moving at a known speed,
+	 * with the given latency between what the shooter saw and when the shot was resolved.
+	 */
+	void RunLagCompensationSelfTest(const TArray<FString>& Args, UWorld* World)
+	{
+		const float LatencyMs = Args.Num() > 0 ? FCString::Atof(*Args[0]) : 150.f;
+		const double Latency = LatencyMs / 1000.0;
+
+		constexpr double FrameTime = 1.0 / 60.0;
+		constexpr double TargetSpeed = 600.0;
+		constexpr float Radius = 55.f;
+		constexpr float HalfHeight = 96.f;
+
+		// Twice the capacity so the buffer has wrapped around
+		FStrikesHitboxHistory History;
+		History.Radius = Radius;
+		History.HalfHeight = HalfHeight;
+		const int32 NumFrames = FStrikesHitboxHistory::Capacity * 2;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			History.Record(Frame * FrameTime, FVector(Frame * FrameTime * TargetSpeed, 0.0, 0.0));
+		}
+		const double Now = (NumFrames - 1) * FrameTime;
+
+		// Every lookup inside the window must match the analytic position
+		int32 Failures = 0;
+		for (double Time = History.GetOldestTime(); Time <= Now; Time += FrameTime * 0.37)
+		{
+			FVector Location;
+			if (!History.Sample(Time, Location) || !Location.Equals(FVector(Time * TargetSpeed, 0.0, 0.0), 0.01))
+			{
+				++Failures;
+			}
+		}
+
+		// Shooter 1000uu to the side aims at where the target was Latency ago
+		const double ShotTime = FMath::Max(Now - Latency, History.GetOldestTime());
+		const FVector Start(ShotTime * TargetSpeed, -1000.0, 0.0);
+		const FVector End = Start + FVector(0.0, 2000.0, 0.0);
+
+		FVector Rewound, Current;
+		float Distance;
+		History.Sample(ShotTime, Rewound);
+		History.Sample(Now, Current);
+		const bool bRewoundHit = SegmentHitsCapsule(Start, End, Rewound, Radius, HalfHeight, Distance);
+		const bool bCurrentHit = SegmentHitsCapsule(Start, End, Current, Radius, HalfHeight, Distance);
+
+		// A target that moved less than its radius is still hit without rewinding
+		const bool bShouldMissUncompensated = (Now - ShotTime) * TargetSpeed > Radius;
+		const bool bPassed = Failures == 0 && bRewoundHit && bCurrentHit != bShouldMissUncompensated;
+
+		UE_LOG(LogStrikesLagComp, Display,
+		       TEXT("Lag compensation self test at %.0f ms: %s (%d bad lookups, rewound hit %d, unrewound hit %d)"),
+		       LatencyMs, bPassed ? TEXT("passed") : TEXT("FAILED"), Failures, bRewoundHit, bCurrentHit);
+
+		if (World != nullptr)
+		{
+			if (const UStrikesLagCompensationSubsystem* LagCompensation =
+				World->GetSubsystem<UStrikesLagCompensationSubsystem>())
+			{
+				UE_LOG(LogStrikesLagComp, Display, TEXT("  %s, tracking %d characters, rewinding up to %.0f ms"),
+				       LagCompensation->IsEnabled() ? TEXT("Enabled") : TEXT("Disabled"),
+				       LagCompensation->GetNumTracked(), LagCompensation->MaxRewindTime * 1000.f);
+			}
+		}
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs CmdLagCompensationSelfTest(
+		TEXT("Strikes.LagComp.SelfTest"),
+		TEXT("Strikes.LagComp.SelfTest [LatencyMs]: checks the hitbox history and rewound traces at a simulated latency. ")
+		TEXT("Combine with 'NetEmulation.PktLag' on a client to try it against real traffic."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunLagCompensationSelfTest));
+}
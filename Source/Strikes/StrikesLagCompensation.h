@@ -0,0 +1,149 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "StrikesLagCompensation.generated.h"
+
+class AStrikesCharacter;
+
+/**
+ * Fixed-size ring buffer of a character's recent capsule positions.
+ * Timestamps and locations live in separate arrays so the binary search only walks the timestamps.
+ * The capsule stays upright, so its location is all that is needed to rebuild it.
+ */
+struct STRIKES_API FStrikesHitboxHistory
+{
+	/** Samples kept per character; a power of two so slots wrap with a mask */
+	static constexpr int32 Capacity = 64;
+
+	/** Server time of each sample */
+	TStaticArray<double, Capacity> Times;
+
+	/** Capsule center of each sample */
+	TStaticArray<FVector, Capacity> Locations;
+
+	/** Capsule size at the last sample */
+	float Radius = 0.f;
+	float HalfHeight = 0.f;
+
+	/**
+	 * Adds a sample, overwriting the oldest one once the buffer is full.
+	 * A sample that isn't newer than the last one replaces it.
+	 */
+	void Record(double Time, const FVector& Location);
+
+	/**
+	 * Capsule center at the given time, interpolated between the two samples around it.
+	 * Times outside the history are clamped to its oldest or newest sample.
+	 *
+	 * @return False if nothing was recorded yet.
+	 */
+	bool Sample(double Time, FVector& OutLocation) const;
+
+	/** Number of samples recorded */
+	int32 Num() const { return Count; }
+
+	/** Time of the oldest sample; only valid if Num() > 0 */
+	double GetOldestTime() const { return Times[Head]; }
+
+	/** Time of the newest sample; only valid if Num() > 0 */
+	double GetNewestTime() const { return Times[ToSlot(Count - 1)]; }
+
+private:
+	/** Slot of the Index-th oldest sample */
+	int32 ToSlot(const int32 Index) const { return (Head + Index) & (Capacity - 1); }
+
+	/** Slot of the oldest sample */
+	int32 Head = 0;
+
+	/** Number of valid samples */
+	int32 Count = 0;
+};
+
+/**
+ * Server-side lag compensation.
+ * Records every character's capsule once per frame, so hitscan and projectile shots can be tested against
+ * the targets where the shooter saw them instead of where they are when the shot reaches the server.
+ */
+UCLASS(config=Game)
+class STRIKES_API UStrikesLagCompensationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Furthest back a shot can rewind targets in seconds; 0 disables lag compensation */
+	UPROPERTY(Config, EditAnywhere, Category="Network")
+	float MaxRewindTime = 0.4f;
+
+	/** Damage applied to a character hit by a rewound shot; 0 only reports the hit */
+	UPROPERTY(Config, EditAnywhere, Category="Network")
+	float CharacterHitDamage = 0.f;
+
+	/** Broadcast on the server for every character hit by a rewound shot */
+	DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnRewoundHit, AStrikesCharacter* /*Target*/, AActor* /*Instigator*/,
+	                                       const FVector& /*Location*/);
+	FOnRewoundHit OnRewoundHit;
+
+	/** Whether shots should be rewound in this world */
+	bool IsEnabled() const;
+
+	/** Clamps a shooter's timestamp to the window covered by the history */
+	double ClampRewindTime(double Time) const;
+
+	/** History of a character, or null if it isn't tracked */
+	const FStrikesHitboxHistory* FindHistory(const AStrikesCharacter* Character) const;
+
+	/**
+	 * Tests a segment against every character's capsule as it was at the given time.
+	 *
+	 * @param Start Start of the segment.
+	 * @param End End of the segment.
+	 * @param Time Server time to rewind the capsules to.
+	 * @param Instigator Actor that fired, never hit.
+	 * @param OutLocation Where the segment enters the closest capsule.
+	 * @return The closest character hit, or null.
+	 */
+	AStrikesCharacter* TraceRewound(const FVector& Start, const FVector& End, double Time, const AActor* Instigator,
+	                                FVector& OutLocation) const;
+
+	/**
+	 * Resolves a shot against the world with characters rewound: the world is traced without characters,
+	 * then the rewound capsules are tested up to the first world hit.
+	 *
+	 * @param Start Start of the shot.
+	 * @param End End of the shot.
+	 * @param Time Server time to rewind the capsules to.
+	 * @param Instigator Actor that fired, ignored by both tests.
+	 * @param Channel Trace channel for the world.
+	 * @param ResponseParams Responses for the world trace.
+	 * @param OutWorldHit First blocking world hit, if any and no character was hit before it.
+	 * @param OutLocation Where the character was hit.
+	 * @return The character hit, or null.
+	 */
+	AStrikesCharacter* ResolveShot(const FVector& Start, const FVector& End, double Time, AActor* Instigator,
+	                               ECollisionChannel Channel, const FCollisionResponseParams& ResponseParams,
+	                               FHitResult& OutWorldHit, FVector& OutLocation) const;
+
+	/** Applies CharacterHitDamage and broadcasts OnRewoundHit */
+	void ApplyRewoundHit(AStrikesCharacter* Target, AActor* Instigator, const FVector& Location,
+	                     const FVector& Direction);
+
+	/** Number of characters with a history */
+	int32 GetNumTracked() const { return Histories.Num(); }
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	// End of FTickableGameObject interface
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** History of every character seen by the server */
+	TMap<TWeakObjectPtr<AStrikesCharacter>, FStrikesHitboxHistory> Histories;
+};
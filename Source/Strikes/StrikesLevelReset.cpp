@@ -0,0 +1,98 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrikesLevelReset.h"
+#include "StrikesProjectileBatch.h"
+#include "StrikesProjectilePool.h"
+#include "StrikesResettable.h"
+#include "StrikesStats.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+
+DEFINE_LOG_CATEGORY(LogStrikesReset);
+
+namespace
+{
+	// Time the last map reload was requested; survives the world being torn down
+	double GLevelReloadStartSeconds = 0.0;
+}
+
+bool UStrikesLevelResetSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// Only game worlds can be reset
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UStrikesLevelResetSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Finish timing a map reload started by the previous world; a cycle stat can't span the world being replaced
+	if (GLevelReloadStartSeconds > 0.0)
+	{
+		LastLevelReloadMs = (FPlatformTime::Seconds() - GLevelReloadStartSeconds) * 1000.0;
+		GLevelReloadStartSeconds = 0.0;
+
+		SET_FLOAT_STAT(STAT_StrikesLastLevelReloadMs, LastLevelReloadMs);
+		CSV_CUSTOM_STAT(Strikes, LevelReloadMs, static_cast<float>(LastLevelReloadMs), ECsvCustomStatOp::Set);
+
+		UE_LOG(LogStrikesReset, Log, TEXT("Level reload took %.2f ms"), LastLevelReloadMs);
+	}
+}
+
+void UStrikesLevelResetSubsystem::Register(UObject* Object)
+{
+	if (Object && Object->Implements<UStrikesResettable>())
+	{
+		Resettables.AddUnique(Object);
+	}
+}
+
+void UStrikesLevelResetSubsystem::ResetLevel()
+{
+	STRIKES_SCOPE_CYCLE_COUNTER(STAT_StrikesSoftReset);
+
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	UWorld* const World = GetWorld();
+
+	// Shots in flight belong to the previous round
+	if (UStrikesProjectilePoolSubsystem* ProjectilePool = World->GetSubsystem<UStrikesProjectilePoolSubsystem>())
+	{
+		ProjectilePool->ReleaseAll();
+	}
+
+	if (UStrikesProjectileBatchSubsystem* ProjectileBatch = World->GetSubsystem<UStrikesProjectileBatchSubsystem>())
+	{
+		ProjectileBatch->Reset();
+	}
+
+	// Drop objects that were destroyed since they registered
+	Resettables.RemoveAll([](const TWeakObjectPtr<UObject>& Object) { return !Object.IsValid(); });
+
+	for (const TWeakObjectPtr<UObject>& Object : Resettables)
+	{
+		CastChecked<IStrikesResettable>(Object.Get())->RestoreInitialState();
+	}
+
+	LastSoftResetMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+
+	SET_FLOAT_STAT(STAT_StrikesLastSoftResetMs, LastSoftResetMs);
+	CSV_CUSTOM_STAT(Strikes, SoftResetMs, static_cast<float>(LastSoftResetMs), ECsvCustomStatOp::Set);
+
+	UE_LOG(LogStrikesReset, Log, TEXT("Soft reset of %d objects took %.2f ms"), Resettables.Num(), LastSoftResetMs);
+}
+
+void UStrikesLevelResetSubsystem::ReloadLevel()
+{
+	GLevelReloadStartSeconds = FPlatformTime::Seconds();
+
+	// Reload the current level to restart the game, taking connected clients along
+	if (GetWorld()->GetNetMode() != NM_Standalone)
+	{
+		GetWorld()->ServerTravel(TEXT("?Restart"));
+	}
+	else
+	{
+		UGameplayStatics::OpenLevel(this, FName(*GetWorld()->GetName()), false);
+	}
+}
@@ -0,0 +1,61 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "StrikesLevelReset.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogStrikesReset, Log, All);
+
+/**
+ * Restarts a round without reloading the map.
+ * Resettable actors and components register here when they begin play and are restored in place on reset,
+ * which avoids tearing down and reloading the world and all of its effects assets.
+ */
+UCLASS(config=Game)
+class STRIKES_API UStrikesLevelResetSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** If true, game over restores the world in place instead of reopening the map. */
+	UPROPERTY(Config, EditAnywhere, Category="Reset")
+	bool bSoftReset = true;
+
+	/**
+	 * Adds an object to the set restored by ResetLevel.
+	 *
+	 * @param Object An object implementing IStrikesResettable.
+	 */
+	void Register(UObject* Object);
+
+	/**
+	 * Restores every registered object and clears in-flight projectiles.
+	 * Must not run from inside a gameplay callback such as a death event, since it restores the objects raising it.
+	 */
+	void ResetLevel();
+
+	/** Reopens the current map, timing how long it takes until the new world begins play. */
+	void ReloadLevel();
+
+	/** Duration of the last soft reset in milliseconds. */
+	UFUNCTION(BlueprintPure, Category="Reset")
+	double GetLastSoftResetMs() const { return LastSoftResetMs; }
+
+	/** Duration of the map reload that opened this world in milliseconds, or 0 if it wasn't reloaded. */
+	UFUNCTION(BlueprintPure, Category="Reset")
+	double GetLastLevelReloadMs() const { return LastLevelReloadMs; }
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Objects restored on reset */
+	TArray<TWeakObjectPtr<UObject>> Resettables;
+
+	double LastSoftResetMs = 0.0;
+	double LastLevelReloadMs = 0.0;
+};
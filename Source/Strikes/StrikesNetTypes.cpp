@@ -0,0 +1,92 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrikesNetTypes.h"
+#include "Engine/NetSerialization.h"
+
+void StrikesNet::SerializeQuantized(FArchive& Ar, float& Value, const float Min, const float Max, const uint32 Bits)
+{
+	const uint32 MaxQuantized = (1u << Bits) - 1;
+	uint32 Quantized = 0;
+
+	if (Ar.IsSaving())
+	{
+		const float Alpha = FMath::Clamp((Value - Min) / (Max - Min), 0.f, 1.f);
+		Quantized = static_cast<uint32>(FMath::RoundToInt32(Alpha * MaxQuantized));
+	}
+
+	Ar.SerializeInt(Quantized, MaxQuantized + 1);
+
+	if (Ar.IsLoading())
+	{
+		Value = Min + (Max - Min) * (static_cast<float>(Quantized) / MaxQuantized);
+	}
+}
+
+bool FStrikesNetHealth::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	StrikesNet::SerializeQuantized(Ar, HealthPercentage, 0.f, 1.f, StrikesNet::PercentageBits);
+
+	bOutSuccess = true;
+	return true;
+}
+
+bool FStrikesNetMagic::operator==(const FStrikesNetMagic& Other) const
+{
+	return MagicFraction == Other.MagicFraction && MagicPercentage == Other.MagicPercentage &&
+		PreviousMagic == Other.PreviousMagic && MagicValue == Other.MagicValue &&
+		MagicCurveStartTime == Other.MagicCurveStartTime && MagicUsableTime == Other.MagicUsableTime &&
+		MagicRegenTime == Other.MagicRegenTime && bMagicCurvePlaying == Other.bMagicCurvePlaying &&
+		bMagicRegenPending == Other.bMagicRegenPending && AckedPredictionKey == Other.AckedPredictionKey &&
+		bAckedPredictionFired == Other.bAckedPredictionFired;
+}
+
+bool FStrikesNetMagic::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	StrikesNet::SerializeQuantized(Ar, MagicFraction, 0.f, 1.f, StrikesNet::PercentageBits);
+	StrikesNet::SerializeQuantized(Ar, MagicPercentage, 0.f, 1.f, StrikesNet::PercentageBits);
+	StrikesNet::SerializeQuantized(Ar, PreviousMagic, 0.f, 1.f, StrikesNet::PercentageBits);
+	StrikesNet::SerializeQuantized(Ar, MagicValue, -1.f, 1.f, StrikesNet::PercentageBits + 1);
+
+	uint8 bCurvePlaying = bMagicCurvePlaying;
+	uint8 bRegenPending = bMagicRegenPending;
+	Ar.SerializeBits(&bCurvePlaying, 1);
+	Ar.SerializeBits(&bRegenPending, 1);
+	bMagicCurvePlaying = bCurvePlaying != 0;
+	bMagicRegenPending = bRegenPending != 0;
+
+	// Timestamps only matter while they are in the future or the curve is playing, so only send those
+	Ar << MagicUsableTime;
+	if (bMagicCurvePlaying)
+	{
+		Ar << MagicCurveStartTime;
+	}
+	if (bMagicRegenPending)
+	{
+		Ar << MagicRegenTime;
+	}
+
+	Ar << AckedPredictionKey;
+
+	uint8 bFired = bAckedPredictionFired;
+	Ar.SerializeBits(&bFired, 1);
+	bAckedPredictionFired = bFired != 0;
+
+	bOutSuccess = true;
+	return true;
+}
+
+bool FStrikesNetProjectileSpawn::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bool bOriginSuccess = true;
+	bool bDirectionSuccess = true;
+	Origin.NetSerialize(Ar, Map, bOriginSuccess);
+	Direction.NetSerialize(Ar, Map, bDirectionSuccess);
+	Ar << SpawnTime;
+
+	uint8 bAsync = bAsyncCollision;
+	Ar.SerializeBits(&bAsync, 1);
+	bAsyncCollision = bAsync != 0;
+
+	bOutSuccess = bOriginSuccess && bDirectionSuccess;
+	return true;
+}
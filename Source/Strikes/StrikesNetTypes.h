@@ -0,0 +1,174 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StrikesNetTypes.generated.h"
+
+class AStrikesProjectile;
+
+namespace StrikesNet
+{
+	/** Bits used for a quantized 0..1 percentage: 1/1023 steps, finer than the whole percent the HUD shows */
+	constexpr uint32 PercentageBits = 10;
+
+	/**
+	 * Writes or reads a value in [Min, Max] quantized to Bits bits.
+	 *
+	 * @param Ar Bit archive to serialize with.
+	 * @param Value Value to write, or receives the value read.
+	 * @param Min Smallest representable value; lower values are clamped.
+	 * @param Max Largest representable value; higher values are clamped.
+	 * @param Bits Number of bits to use.
+	 */
+	STRIKES_API void SerializeQuantized(FArchive& Ar, float& Value, float Min, float Max, uint32 Bits);
+
+	/** Whether prediction key A was issued no later than B; keys wrap around, and 0 means no prediction */
+	inline bool IsKeyAtOrBefore(const uint16 A, const uint16 B)
+	{
+		return static_cast<int16>(A - B) <= 0;
+	}
+}
+
+/**
+ * Replicated health of a character: the percentage quantized to StrikesNet::PercentageBits.
+ * The absolute health is derived from FullHealth on the receiving side.
+ */
+USTRUCT()
+struct FStrikesNetHealth
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	float HealthPercentage = 1.f;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FStrikesNetHealth& Other) const
+	{
+		return HealthPercentage == Other.HealthPercentage;
+	}
+};
+
+template <>
+struct TStructOpsTypeTraits<FStrikesNetHealth> : public TStructOpsTypeTraitsBase2<FStrikesNetHealth>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true
+	};
+};
+
+/**
+ * Replicated magic state of a character: everything a client needs to evaluate the magic curve itself.
+ * Percentages are quantized to StrikesNet::PercentageBits, timestamps are sent as 32-bit server times.
+ */
+USTRUCT()
+struct FStrikesNetMagic
+{
+	GENERATED_BODY()
+
+	/** Magic amount divided by FullMagic */
+	UPROPERTY()
+	float MagicFraction = 1.f;
+
+	UPROPERTY()
+	float MagicPercentage = 1.f;
+
+	UPROPERTY()
+	float PreviousMagic = 1.f;
+
+	/** Change in magic percentage scaled by the curve, between -1 and 1 */
+	UPROPERTY()
+	float MagicValue = 0.f;
+
+	UPROPERTY()
+	float MagicCurveStartTime = 0.f;
+
+	UPROPERTY()
+	float MagicUsableTime = 0.f;
+
+	UPROPERTY()
+	float MagicRegenTime = 0.f;
+
+	UPROPERTY()
+	bool bMagicCurvePlaying = false;
+
+	UPROPERTY()
+	bool bMagicRegenPending = false;
+
+	/** Latest prediction key of the owning client that the server has processed */
+	UPROPERTY()
+	uint16 AckedPredictionKey = 0;
+
+	/** Whether the server fired the shot of AckedPredictionKey, rather than dropping it */
+	UPROPERTY()
+	bool bAckedPredictionFired = false;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FStrikesNetMagic& Other) const;
+};
+
+template <>
+struct TStructOpsTypeTraits<FStrikesNetMagic> : public TStructOpsTypeTraitsBase2<FStrikesNetMagic>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true
+	};
+};
+
+/**
+ * Magic spend applied by the owning client before the server confirmed it.
+ */
+struct FStrikesMagicPrediction
+{
+	/** Key sent to the server with the shot */
+	uint16 Key = 0;
+
+	/** Server time the client predicted the shot at */
+	double Time = 0.0;
+
+	/** Magic state right after the predicted spend, shown again while the server hasn't answered */
+	FStrikesNetMagic State;
+};
+
+/**
+ * A projectile launch sent to clients instead of replicating a projectile actor.
+ * Clients simulate the projectile themselves from the origin, direction and server spawn time.
+ */
+USTRUCT()
+struct FStrikesNetProjectileSpawn
+{
+	GENERATED_BODY()
+
+	/** Launch location, sent with 0.1 uu precision */
+	UPROPERTY()
+	FVector_NetQuantize10 Origin = FVector::ZeroVector;
+
+	/** Launch direction, sent as a unit vector with 16 bits per component */
+	UPROPERTY()
+	FVector_NetQuantizeNormal Direction = FVector::ForwardVector;
+
+	/** Server world time of the launch */
+	UPROPERTY()
+	float SpawnTime = 0.f;
+
+	/** Whether the projectile uses async collision */
+	UPROPERTY()
+	bool bAsyncCollision = false;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template <>
+struct TStructOpsTypeTraits<FStrikesNetProjectileSpawn> : public TStructOpsTypeTraitsBase2<FStrikesNetProjectileSpawn>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
@@ -0,0 +1,410 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrikesPerfRun.h"
+#include "StrikesBots.h"
+#include "StrikesDamageZones.h"
+#include "StrikesProjectile.h"
+#include "StrikesProjectileBatch.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogStrikesPerf, Log, All);
+
+void FStrikesPerfReport::Add(const FString& Name, const double Value)
+{
+	Names.Add(Name);
+	Values.Add(Value);
+}
+
+const double* FStrikesPerfReport::Find(const FString& Name) const
+{
+	const int32 Index = Names.IndexOfByKey(Name);
+	return Index != INDEX_NONE ? &Values[Index] : nullptr;
+}
+
+bool FStrikesPerfReport::Save(const FString& Path) const
+{
+	FString Text = TEXT("Metric,Value\n");
+	for (int32 Index = 0; Index < Names.Num(); ++Index)
+	{
+		Text += FString::Printf(TEXT("%s,%.3f\n"), *Names[Index], Values[Index]);
+	}
+	return FFileHelper::SaveStringToFile(Text, *Path);
+}
+
+bool FStrikesPerfReport::Load(const FString& Path)
+{
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *Path))
+	{
+		return false;
+	}
+
+	Names.Reset();
+	Values.Reset();
+
+	// Skip the header
+	for (int32 Index = 1; Index < Lines.Num(); ++Index)
+	{
+		FString Name, Value;
+		if (Lines[Index].Split(TEXT(","), &Name, &Value))
+		{
+			Add(Name, FCString::Atod(*Value));
+		}
+	}
+	return true;
+}
+
+int32 FStrikesPerfReport::Diff(const FStrikesPerfReport& Baseline, const FStrikesPerfReport& Report,
+                               const double Tolerance)
+{
+	int32 Regressions = 0;
+	int32 WorkloadChanges = 0;
+
+	for (int32 Index = 0; Index < Report.Names.Num(); ++Index)
+	{
+		const FString& Name = Report.Names[Index];
+		const double Value = Report.Values[Index];
+		const double* BaseValue = Baseline.Find(Name);
+		if (BaseValue == nullptr)
+		{
+			UE_LOG(LogStrikesPerf, Display, TEXT("  %-24s %12.3f  (not in baseline)"), *Name, Value);
+			continue;
+		}
+
+		const double Change = Value - *BaseValue;
+		const double RelativeChange = *BaseValue != 0.0 ? Change / FMath::Abs(*BaseValue) : (Change != 0.0 ? 1.0 : 0.0);
+
+		// Frame times and hitches are what we guard. The run length follows frame times, so it is only shown;
+		// everything else describes how much work the run did
+		const bool bCostMetric = Name.StartsWith(TEXT("FrameMs")) || Name.EndsWith(TEXT("Hitches"));
+		const bool bRunLength = Name == TEXT("Frames") || Name == TEXT("Seconds");
+		const TCHAR* Verdict = TEXT("");
+		if (bCostMetric && RelativeChange > Tolerance)
+		{
+			Verdict = TEXT("REGRESSION");
+			++Regressions;
+		}
+		else if (bCostMetric && RelativeChange < -Tolerance)
+		{
+			Verdict = TEXT("improved");
+		}
+		else if (!bCostMetric && !bRunLength && FMath::Abs(RelativeChange) > Tolerance)
+		{
+			Verdict = TEXT("workload changed");
+			++WorkloadChanges;
+		}
+
+		UE_LOG(LogStrikesPerf, Display, TEXT("  %-24s %12.3f -> %12.3f  %+7.1f%%  %s"),
+		       *Name, *BaseValue, Value, RelativeChange * 100.0, Verdict);
+	}
+
+	if (WorkloadChanges > 0)
+	{
+		UE_LOG(LogStrikesPerf, Warning,
+		       TEXT("%d workload metrics changed by more than %.0f%%: ")
+		       TEXT("the runs did different work, compare timings with care"),
+		       WorkloadChanges, Tolerance * 100.0);
+	}
+
+	return Regressions;
+}
+
+bool UStrikesPerfRunSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// Only game worlds are profiled
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UStrikesPerfRunSubsystem::IsTickable() const
+{
+	if (Phase != EStrikesPerfRunPhase::EIdle)
+	{
+		return true;
+	}
+
+#if CSV_PROFILER
+	return FCsvProfiler::Get()->IsCapturing();
+#else
+	return false;
+#endif
+}
+
+TStatId UStrikesPerfRunSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UStrikesPerfRunSubsystem, STATGROUP_Tickables);
+}
+
+void UStrikesPerfRunSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FMemory::Memcpy(LastEventTotals, StrikesFrameEvents::Totals, sizeof(LastEventTotals));
+	LastEventFrame = GFrameCounter;
+}
+
+void UStrikesPerfRunSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// The session is played by the server or a standalone game
+	if (!FParse::Param(FCommandLine::Get(), TEXT("StrikesPerfRun")) || InWorld.GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	// Every run plays the same map so reports stay comparable
+	const FString MapName = UWorld::RemovePIEPrefix(InWorld.GetOutermost()->GetName());
+	if (MapName != Map)
+	{
+		UE_LOG(LogStrikesPerf, Display, TEXT("Perf run: opening %s"), *Map);
+		UGameplayStatics::OpenLevel(&InWorld, FName(*Map));
+		return;
+	}
+
+	if (UStrikesBotSubsystem* Bots = InWorld.GetSubsystem<UStrikesBotSubsystem>())
+	{
+		Bots->SpawnBots(NumBots);
+	}
+
+	RunName = FString::Printf(TEXT("PerfRun-%s"), *FDateTime::Now().ToString());
+	Phase = EStrikesPerfRunPhase::EWarmup;
+	PhaseStartTime = FPlatformTime::Seconds();
+	LastFrameTime = PhaseStartTime;
+
+	UE_LOG(LogStrikesPerf, Display, TEXT("Perf run: %d bots, %.0f s warmup, %.0f s measured"),
+	       NumBots, WarmupSeconds, DurationSeconds);
+}
+
+void UStrikesPerfRunSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double Now = FPlatformTime::Seconds();
+	const double FrameMs = (Now - LastFrameTime) * 1000.0;
+	LastFrameTime = Now;
+
+	if (Phase == EStrikesPerfRunPhase::EMeasure)
+	{
+		FrameTimesMs.Add(static_cast<float>(FrameMs));
+	}
+
+	RecordFrame();
+
+	if (Phase == EStrikesPerfRunPhase::EWarmup && Now - PhaseStartTime >= WarmupSeconds)
+	{
+		BeginMeasuring(Now);
+	}
+	else if (Phase == EStrikesPerfRunPhase::EMeasure && Now - PhaseStartTime >= DurationSeconds)
+	{
+		FinishRun();
+	}
+}
+
+void UStrikesPerfRunSubsystem::RecordFrame()
+{
+	const UWorld* World = GetWorld();
+
+	int32 NumProjectiles = AStrikesProjectile::GetNumLive();
+	if (const UStrikesProjectileBatchSubsystem* Batch = World->GetSubsystem<UStrikesProjectileBatchSubsystem>())
+	{
+		NumProjectiles += Batch->GetNumProjectiles();
+	}
+
+	const UStrikesDamageZoneSubsystem* DamageZones = World->GetSubsystem<UStrikesDamageZoneSubsystem>();
+	const int32 NumDamageZones = DamageZones != nullptr ? DamageZones->GetNumActiveZones() : 0;
+
+	// Events that happened while nothing was recording belong to no frame
+	if (LastEventFrame + 1 != GFrameCounter)
+	{
+		FMemory::Memcpy(LastEventTotals, StrikesFrameEvents::Totals, sizeof(LastEventTotals));
+	}
+	LastEventFrame = GFrameCounter;
+
+	int32 Events[static_cast<int32>(EStrikesFrameEvent::ENum)];
+	for (int32 Index = 0; Index < static_cast<int32>(EStrikesFrameEvent::ENum); ++Index)
+	{
+		Events[Index] = static_cast<int32>(StrikesFrameEvents::Totals[Index] - LastEventTotals[Index]);
+		LastEventTotals[Index] = StrikesFrameEvents::Totals[Index];
+	}
+
+	CSV_CUSTOM_STAT(Strikes, Projectiles, NumProjectiles, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Strikes, DamageZones, NumDamageZones, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Strikes, DamageEvents, Events[static_cast<int32>(EStrikesFrameEvent::EDamageEvent)],
+	                ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Strikes, HUDUpdates, Events[static_cast<int32>(EStrikesFrameEvent::EHUDUpdate)],
+	                ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Strikes, TimerOps, Events[static_cast<int32>(EStrikesFrameEvent::ETimerOp)],
+	                ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Strikes, TimerOpsAvoided, Events[static_cast<int32>(EStrikesFrameEvent::ETimerOpAvoided)],
+	                ECsvCustomStatOp::Set);
+
+	if (Phase != EStrikesPerfRunPhase::EMeasure)
+	{
+		return;
+	}
+
+	for (int32 Index = 0; Index < static_cast<int32>(EStrikesFrameEvent::ENum); ++Index)
+	{
+		EventTotals[Index] += Events[Index];
+	}
+	ProjectileFrames += NumProjectiles;
+	MaxProjectiles = FMath::Max(MaxProjectiles, NumProjectiles);
+	DamageZoneFrames += NumDamageZones;
+	MaxDamageZones = FMath::Max(MaxDamageZones, NumDamageZones);
+}
+
+void UStrikesPerfRunSubsystem::BeginMeasuring(const double Now)
+{
+	Phase = EStrikesPerfRunPhase::EMeasure;
+	PhaseStartTime = Now;
+
+	FrameTimesMs.Reset();
+	FrameTimesMs.Reserve(FMath::CeilToInt(DurationSeconds * 120.f));
+	FMemory::Memzero(EventTotals, sizeof(EventTotals));
+	ProjectileFrames = 0;
+	MaxProjectiles = 0;
+	DamageZoneFrames = 0;
+	MaxDamageZones = 0;
+
+#if CSV_PROFILER
+	if (bCaptureCsv && !FCsvProfiler::Get()->IsCapturing())
+	{
+		FCsvProfiler::Get()->BeginCapture(-1, FPaths::ProfilingDir() / TEXT("Strikes"), RunName + TEXT("-Frames.csv"));
+	}
+#endif
+
+	UE_LOG(LogStrikesPerf, Display, TEXT("Perf run: measuring"));
+}
+
+FStrikesPerfReport UStrikesPerfRunSubsystem::BuildReport() const
+{
+	FStrikesPerfReport Report;
+
+	const int32 NumFrames = FrameTimesMs.Num();
+	TArray<float> Sorted = FrameTimesMs;
+	Sorted.Sort();
+
+	const auto Percentile = [&Sorted, NumFrames](const double Fraction)
+	{
+		return NumFrames > 0 ? Sorted[FMath::Clamp(FMath::CeilToInt(Fraction * NumFrames) - 1, 0, NumFrames - 1)] : 0.f;
+	};
+
+	double SumMs = 0.0;
+	int32 Hitches = 0;
+	int32 SevereHitches = 0;
+	for (const float FrameMs : FrameTimesMs)
+	{
+		SumMs += FrameMs;
+		Hitches += FrameMs > HitchThresholdMs ? 1 : 0;
+		SevereHitches += FrameMs > SevereHitchThresholdMs ? 1 : 0;
+	}
+	const double Frames = FMath::Max(NumFrames, 1);
+
+	Report.Add(TEXT("Seconds"), SumMs / 1000.0);
+	Report.Add(TEXT("Bots"), NumBots);
+	Report.Add(TEXT("Frames"), NumFrames);
+	Report.Add(TEXT("FrameMsAvg"), SumMs / Frames);
+	Report.Add(TEXT("FrameMsP50"), Percentile(0.5));
+	Report.Add(TEXT("FrameMsP90"), Percentile(0.9));
+	Report.Add(TEXT("FrameMsP95"), Percentile(0.95));
+	Report.Add(TEXT("FrameMsP99"), Percentile(0.99));
+	Report.Add(TEXT("FrameMsMax"), NumFrames > 0 ? Sorted.Last() : 0.f);
+	Report.Add(TEXT("Hitches"), Hitches);
+	Report.Add(TEXT("SevereHitches"), SevereHitches);
+	Report.Add(TEXT("ProjectilesAvg"), static_cast<double>(ProjectileFrames) / Frames);
+	Report.Add(TEXT("ProjectilesMax"), MaxProjectiles);
+	Report.Add(TEXT("DamageZonesAvg"), static_cast<double>(DamageZoneFrames) / Frames);
+	Report.Add(TEXT("DamageZonesMax"), MaxDamageZones);
+	const auto EventTotal = [this](const EStrikesFrameEvent Event)
+	{
+		return static_cast<double>(EventTotals[static_cast<int32>(Event)]);
+	};
+	Report.Add(TEXT("DamageEvents"), EventTotal(EStrikesFrameEvent::EDamageEvent));
+	Report.Add(TEXT("HUDUpdates"), EventTotal(EStrikesFrameEvent::EHUDUpdate));
+	Report.Add(TEXT("TimerOps"), EventTotal(EStrikesFrameEvent::ETimerOp));
+	Report.Add(TEXT("TimerOpsAvoided"), EventTotal(EStrikesFrameEvent::ETimerOpAvoided));
+
+	return Report;
+}
+
+void UStrikesPerfRunSubsystem::FinishRun()
+{
+	Phase = EStrikesPerfRunPhase::EIdle;
+
+#if CSV_PROFILER
+	if (bCaptureCsv)
+	{
+		FCsvProfiler::Get()->EndCapture();
+	}
+#endif
+
+	const FStrikesPerfReport Report = BuildReport();
+	const FString ReportPath = FPaths::ProfilingDir() / TEXT("Strikes") / RunName + TEXT(".csv");
+	if (Report.Save(ReportPath))
+	{
+		UE_LOG(LogStrikesPerf, Display, TEXT("Perf run: wrote %s"), *ReportPath);
+	}
+	else
+	{
+		UE_LOG(LogStrikesPerf, Error, TEXT("Perf run: could not write %s"), *ReportPath);
+	}
+
+	int32 Regressions = 0;
+	FString BaselinePath;
+	if (FParse::Value(FCommandLine::Get(), TEXT("StrikesPerfBaseline="), BaselinePath))
+	{
+		FStrikesPerfReport Baseline;
+		if (Baseline.Load(BaselinePath))
+		{
+			UE_LOG(LogStrikesPerf, Display, TEXT("Perf run: diff against %s"), *BaselinePath);
+			Regressions = FStrikesPerfReport::Diff(Baseline, Report, RegressionTolerance);
+			UE_LOG(LogStrikesPerf, Display, TEXT("Perf run: %d regressions"), Regressions);
+		}
+		else
+		{
+			UE_LOG(LogStrikesPerf, Error, TEXT("Perf run: could not read baseline %s"), *BaselinePath);
+		}
+	}
+
+	if (bExitWhenDone)
+	{
+		FPlatformMisc::RequestExitWithStatus(false, Regressions > 0 ? 1 : 0);
+	}
+}
+
+namespace
+{
+	/** Diffs two perf run reports in the log */
+	void DiffPerfReports(const TArray<FString>& Args)
+	{
+		if (Args.Num() < 2)
+		{
+			UE_LOG(LogStrikesPerf, Display, TEXT("Usage: Strikes.PerfRun.Diff <BaselineReport> <Report> [TolerancePercent]"));
+			return;
+		}
+
+		FStrikesPerfReport Baseline, Report;
+		if (!Baseline.Load(Args[0]) || !Report.Load(Args[1]))
+		{
+			UE_LOG(LogStrikesPerf, Error, TEXT("Could not read %s or %s"), *Args[0], *Args[1]);
+			return;
+		}
+
+		const double Tolerance = Args.Num() > 2
+			                         ? FCString::Atod(*Args[2]) / 100.0
+			                         : GetDefault<UStrikesPerfRunSubsystem>()->RegressionTolerance;
+		const int32 Regressions = FStrikesPerfReport::Diff(Baseline, Report, Tolerance);
+		UE_LOG(LogStrikesPerf, Display, TEXT("%d regressions"), Regressions);
+	}
+
+	FAutoConsoleCommand CmdDiffPerfReports(
+		TEXT("Strikes.PerfRun.Diff"),
+		TEXT("Strikes.PerfRun.Diff <BaselineReport> <Report> [TolerancePercent]: compares two -StrikesPerfRun reports ")
+		TEXT("and flags frame time and hitch metrics that got worse."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&DiffPerfReports));
+}
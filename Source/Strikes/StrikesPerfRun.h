@@ -0,0 +1,160 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StrikesStats.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "StrikesPerfRun.generated.h"
+
+/** Summary of a perf run: named numeric metrics, saved as "Metric,Value" rows so two runs diff line by line */
+struct STRIKES_API FStrikesPerfReport
+{
+	/** Metric names, in the order they are written */
+	TArray<FString> Names;
+
+	/** Metric values, parallel to Names */
+	TArray<double> Values;
+
+	/** Appends a metric */
+	void Add(const FString& Name, double Value);
+
+	/** Returns the value of a metric, or null if the report has no such metric */
+	const double* Find(const FString& Name) const;
+
+	/** Writes the report as CSV; returns false if the file could not be written */
+	bool Save(const FString& Path) const;
+
+	/** Reads a report written by Save; returns false if the file could not be read */
+	bool Load(const FString& Path);
+
+	/**
+	 * Logs every metric of a report next to its baseline value.
+	 * Frame time and hitch metrics that grew by more than the tolerance are regressions;
+	 * workload metrics (projectiles, damage, HUD updates, timers) that changed are reported as warnings,
+	 * since the runs did different work and their timings are not comparable.
+	 * Frames and Seconds follow the frame times of a fixed-length run, so they are only shown.
+	 *
+	 * @param Baseline Report of the reference run.
+	 * @param Report Report of the run being checked.
+	 * @param Tolerance Relative change allowed before a metric is flagged, e.g. 0.05 for 5%.
+	 * @return Number of regressed metrics.
+	 */
+	static int32 Diff(const FStrikesPerfReport& Baseline, const FStrikesPerfReport& Report, double Tolerance);
+};
+
+/** Phase of a -StrikesPerfRun session */
+UENUM()
+enum class EStrikesPerfRunPhase : uint8
+{
+	/** No perf run; only the CSV stats are recorded while a capture is running */
+	EIdle,
+
+	/** Bots are spawned and the level settles before measuring */
+	EWarmup,
+
+	/** Every frame is recorded for the report */
+	EMeasure
+};
+
+/**
+ * Records the Strikes CSV profiler category every frame while a CSV capture is running:
+ * live projectiles, active damage zones, damage events, HUD updates and timer operations.
+ *
+ * Started with -StrikesPerfRun, it also plays a scripted session: it opens Map, spawns NumBots bots with fixed
+ * seeds, waits WarmupSeconds, then measures DurationSeconds of frames and writes a summary report with frame time
+ * percentiles, hitch counts and per-category totals to Saved/Profiling/Strikes/PerfRun-<date>.csv.
+ * With -StrikesPerfBaseline=<report> the new report is diffed against the baseline and the process exits with
+ * status 1 if anything regressed.
+ */
+UCLASS(config=Game)
+class STRIKES_API UStrikesPerfRunSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Package name of the map perf runs are played on */
+	UPROPERTY(Config, EditAnywhere, Category="Perf Run")
+	FString Map = TEXT("/Game/FirstPerson/Maps/FirstPersonMap");
+
+	/** Bots spawned for the session */
+	UPROPERTY(Config, EditAnywhere, Category="Perf Run")
+	int32 NumBots = 32;
+
+	/** Seconds played before measuring, so spawning and loading don't count */
+	UPROPERTY(Config, EditAnywhere, Category="Perf Run")
+	float WarmupSeconds = 5.f;
+
+	/** Seconds measured */
+	UPROPERTY(Config, EditAnywhere, Category="Perf Run")
+	float DurationSeconds = 60.f;
+
+	/** Frames longer than this many milliseconds count as hitches */
+	UPROPERTY(Config, EditAnywhere, Category="Perf Run")
+	float HitchThresholdMs = 33.3f;
+
+	/** Frames longer than this many milliseconds count as severe hitches */
+	UPROPERTY(Config, EditAnywhere, Category="Perf Run")
+	float SevereHitchThresholdMs = 100.f;
+
+	/** Relative change of a metric allowed before a diff flags it */
+	UPROPERTY(Config, EditAnywhere, Category="Perf Run")
+	float RegressionTolerance = 0.05f;
+
+	/** Whether to capture the per-frame CSV profile next to the report */
+	UPROPERTY(Config, EditAnywhere, Category="Perf Run")
+	bool bCaptureCsv = true;
+
+	/** Whether to quit once the report is written */
+	UPROPERTY(Config, EditAnywhere, Category="Perf Run")
+	bool bExitWhenDone = true;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	// End of FTickableGameObject interface
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Writes this frame's values of the Strikes CSV category and adds them to the run totals when measuring */
+	void RecordFrame();
+
+	/** Starts measuring after the warmup */
+	void BeginMeasuring(double Now);
+
+	/** Writes the report, diffs it against the baseline if one was given, and quits if configured to */
+	void FinishRun();
+
+	/** Builds the summary of the measured frames */
+	FStrikesPerfReport BuildReport() const;
+
+	/** Current phase */
+	EStrikesPerfRunPhase Phase = EStrikesPerfRunPhase::EIdle;
+
+	/** Real time the current phase and the last frame started */
+	double PhaseStartTime = 0.0;
+	double LastFrameTime = 0.0;
+
+	/** Base name of the report and CSV capture files */
+	FString RunName;
+
+	/** Event totals at the last recorded frame, and the frame they were taken on */
+	int64 LastEventTotals[static_cast<int32>(EStrikesFrameEvent::ENum)] = {};
+	uint64 LastEventFrame = 0;
+
+	/** Measured frame times in milliseconds */
+	TArray<float> FrameTimesMs;
+
+	/** Totals over the measured frames */
+	int64 EventTotals[static_cast<int32>(EStrikesFrameEvent::ENum)] = {};
+	int64 ProjectileFrames = 0;
+	int32 MaxProjectiles = 0;
+	int64 DamageZoneFrames = 0;
+	int32 MaxDamageZones = 0;
+};
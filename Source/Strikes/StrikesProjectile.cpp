@@ -1,8 +1,13 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "StrikesProjectile.h"
+#include "StrikesProjectilePool.h"
+#include "StrikesStats.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "Components/SphereComponent.h"
+#include "Engine/CollisionProfile.h"
+
+int32 AStrikesProjectile::NumLive = 0;
 
 AStrikesProjectile::AStrikesProjectile() 
 {
@@ -29,15 +34,140 @@ AStrikesProjectile::AStrikesProjectile()
 
 	// Die after 3 seconds by default
 	InitialLifeSpan = 3.0f;
+
+	// Projectiles are spawned and simulated by the server and replicated to clients
+	bReplicates = true;
+	SetReplicateMovement(true);
+}
+
+void AStrikesProjectile::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Pooled projectiles start parked in the pool and count once they are launched
+	SetCountedLive(!IsPooled());
+}
+
+void AStrikesProjectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	SetCountedLive(false);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AStrikesProjectile::SetCountedLive(const bool bLive)
+{
+	if (bLive == bCountedLive)
+	{
+		return;
+	}
+
+	bCountedLive = bLive;
+	if (bLive)
+	{
+		++NumLive;
+		INC_DWORD_STAT(STAT_StrikesLiveProjectiles);
+	}
+	else
+	{
+		--NumLive;
+		DEC_DWORD_STAT(STAT_StrikesLiveProjectiles);
+	}
 }
 
 void AStrikesProjectile::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
 {
-	// Only add impulse and destroy projectile if we hit a physics
-	if ((OtherActor != nullptr) && (OtherActor != this) && (OtherComp != nullptr) && OtherComp->IsSimulatingPhysics())
+	STRIKES_SCOPE_CYCLE_COUNTER(STAT_StrikesProjectileHit);
+
+	// Only add impulse and destroy projectile if we hit a physics; the server owns both
+	if (HasAuthority() && (OtherActor != nullptr) && (OtherActor != this) && (OtherComp != nullptr) && OtherComp->IsSimulatingPhysics())
 	{
 		OtherComp->AddImpulseAtLocation(GetVelocity() * 100.0f, GetActorLocation());
+		INC_DWORD_STAT(STAT_StrikesHits);
+
+		Release();
+	}
+}
+
+void AStrikesProjectile::GetCollisionChannelAndResponse(ECollisionChannel& OutChannel,
+                                                        FCollisionResponseParams& OutResponseParams)
+{
+	// Fall back to the Projectile object channel from DefaultEngine.ini if the profile is missing
+	if (!UCollisionProfile::GetChannelAndResponseParams(FName(TEXT("Projectile")), OutChannel, OutResponseParams))
+	{
+		OutChannel = ECC_GameTraceChannel1;
+		OutResponseParams = FCollisionResponseParams::DefaultResponseParam;
+	}
+}
 
+void AStrikesProjectile::LifeSpanExpired()
+{
+	if (IsPooled())
+	{
+		Release();
+		return;
+	}
+
+	Super::LifeSpanExpired();
+}
+
+void AStrikesProjectile::Release()
+{
+	if (UStrikesProjectilePoolSubsystem* OwningPool = Pool.Get())
+	{
+		OwningPool->Release(this);
+	}
+	else
+	{
 		Destroy();
 	}
+}
+
+void AStrikesProjectile::ActivatePooled(const FVector& Location, const FRotator& Rotation)
+{
+	// Move without sweeping; collision is still disabled at this point
+	SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::ResetPhysics);
+
+	// Restore collision state
+	CollisionComp->ClearMoveIgnoreActors();
+	SetActorEnableCollision(true);
+	SetActorHiddenInGame(false);
+
+	// The movement component drops its updated component once a bounce comes to rest, so hook it up again
+	ProjectileMovement->SetUpdatedComponent(CollisionComp);
+	ProjectileMovement->Velocity = Rotation.Vector() * ProjectileMovement->InitialSpeed;
+	ProjectileMovement->UpdateComponentVelocity();
+	ProjectileMovement->Activate(true);
+
+	// Same lifetime a freshly spawned projectile of this class would get
+	SetLifeSpan(GetClass()->GetDefaultObject<AStrikesProjectile>()->InitialLifeSpan);
+
+	// Replicate again while flying
+	if (HasAuthority())
+	{
+		SetNetDormancy(DORM_Awake);
+	}
+
+	SetCountedLive(true);
+}
+
+void AStrikesProjectile::DeactivatePooled()
+{
+	SetLifeSpan(0.f);
+
+	// Reset velocity and stop ticking the movement component
+	ProjectileMovement->StopMovementImmediately();
+	ProjectileMovement->Deactivate();
+
+	// Reset collision state
+	SetActorEnableCollision(false);
+	SetActorHiddenInGame(true);
+
+	// Nothing changes while it waits in the pool, so stop considering it for replication once clients saw it hide
+	if (HasAuthority())
+	{
+		SetNetDormancy(DORM_DormantAll);
+	}
+
+	SetCountedLive(false);
 }
\ No newline at end of file
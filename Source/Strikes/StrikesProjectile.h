@@ -8,6 +8,7 @@
 
 class USphereComponent;
 class UProjectileMovementComponent;
+class UStrikesProjectilePoolSubsystem;
 
 UCLASS(config=Game)
 class AStrikesProjectile : public AActor
@@ -29,9 +30,56 @@ public:
 	UFUNCTION()
 	void OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
 
+	/**
+	 * Gets the collision channel and responses of the "Projectile" collision profile,
+	 * for queries that should collide like a projectile actor does.
+	 *
+	 * @param OutChannel Object channel of the profile.
+	 * @param OutResponseParams Per-channel responses of the profile.
+	 */
+	static void GetCollisionChannelAndResponse(ECollisionChannel& OutChannel, FCollisionResponseParams& OutResponseParams);
+
+	/** Places the projectile at the given transform and launches it again after being parked in the pool */
+	void ActivatePooled(const FVector& Location, const FRotator& Rotation);
+
+	/** Stops, hides and disables collision so the projectile can wait in the pool */
+	void DeactivatePooled();
+
+	/** Marks this projectile as owned by the given pool */
+	void SetPool(UStrikesProjectilePoolSubsystem* InPool) { Pool = InPool; }
+
+	/** Returns true if this projectile is recycled through a pool instead of being destroyed */
+	bool IsPooled() const { return Pool.IsValid(); }
+
+	/** Number of projectile actors flying in every world; pooled projectiles waiting in the pool are not counted */
+	static int32 GetNumLive() { return NumLive; }
+
 	/** Returns CollisionComp subobject **/
 	USphereComponent* GetCollisionComp() const { return CollisionComp; }
 	/** Returns ProjectileMovement subobject **/
 	UProjectileMovementComponent* GetProjectileMovement() const { return ProjectileMovement; }
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Returns pooled projectiles to their pool instead of destroying them */
+	virtual void LifeSpanExpired() override;
+
+private:
+	/** Hands the projectile back to its pool, or destroys it if it is not pooled */
+	void Release();
+
+	/** Adds or removes the projectile from the live projectile count */
+	void SetCountedLive(bool bLive);
+
+	/** True while the projectile is counted in NumLive and the live projectiles stat */
+	bool bCountedLive = false;
+
+	/** Projectile actors currently counted as live */
+	static int32 NumLive;
+
+	/** Pool that owns this projectile, if any */
+	TWeakObjectPtr<UStrikesProjectilePoolSubsystem> Pool;
 };
 
@@ -0,0 +1,486 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrikesProjectileBatch.h"
+#include "StrikesProjectile.h"
+#include "StrikesStats.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/SphereComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+
+bool UStrikesProjectileBatchSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// Only game worlds fire projectiles
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UStrikesProjectileBatchSubsystem::Deinitialize()
+{
+	Reset();
+	Archetypes.Empty();
+	RenderActor = nullptr;
+
+	Super::Deinitialize();
+}
+
+bool UStrikesProjectileBatchSubsystem::IsTickable() const
+{
+	// Nothing to simulate while no projectile is in flight
+	return Life.Num() > 0;
+}
+
+TStatId UStrikesProjectileBatchSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UStrikesProjectileBatchSubsystem, STATGROUP_Tickables);
+}
+
+int32 UStrikesProjectileBatchSubsystem::FindOrAddArchetype(const TSubclassOf<AStrikesProjectile> ProjectileClass)
+{
+	const int32 ExistingIndex = Archetypes.IndexOfByPredicate(
+		[ProjectileClass](const FStrikesBatchedProjectileArchetype& Archetype)
+		{
+			return Archetype.ProjectileClass == ProjectileClass;
+		});
+
+	if (ExistingIndex != INDEX_NONE)
+	{
+		return ExistingIndex;
+	}
+
+	// Archetype indices are stored as bytes
+	if (Archetypes.Num() > MAX_uint8)
+	{
+		return INDEX_NONE;
+	}
+
+	UWorld* const World = GetWorld();
+
+	// Read the movement settings from the class defaults, including Blueprint overrides
+	const AStrikesProjectile* Defaults = ProjectileClass->GetDefaultObject<AStrikesProjectile>();
+	const UProjectileMovementComponent* Movement = Defaults->GetProjectileMovement();
+
+	FStrikesBatchedProjectileArchetype& Archetype = Archetypes.AddDefaulted_GetRef();
+	Archetype.ProjectileClass = ProjectileClass;
+	Archetype.Radius = Defaults->GetCollisionComp()->GetScaledSphereRadius();
+	Archetype.InitialSpeed = Movement->InitialSpeed;
+	Archetype.MaxSpeed = Movement->MaxSpeed;
+	Archetype.GravityZ = World->GetGravityZ() * Movement->ProjectileGravityScale;
+	Archetype.Bounciness = Movement->Bounciness;
+	Archetype.Friction = Movement->Friction;
+	Archetype.BounceStopSpeed = Movement->BounceVelocityStopSimulatingThreshold;
+	Archetype.LifeSpan = Defaults->InitialLifeSpan;
+	Archetype.bShouldBounce = Movement->bShouldBounce;
+
+	// All instanced meshes live on a single actor that is never moved
+	if (RenderActor == nullptr)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		RenderActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+
+		USceneComponent* Root = NewObject<USceneComponent>(RenderActor, TEXT("Root"));
+		RenderActor->SetRootComponent(Root);
+		Root->RegisterComponent();
+	}
+
+	UInstancedStaticMeshComponent* Instances = NewObject<UInstancedStaticMeshComponent>(RenderActor);
+	Instances->SetStaticMesh(ProjectileMesh.LoadSynchronous());
+	Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Instances->SetCastShadow(false);
+	Instances->SetupAttachment(RenderActor->GetRootComponent());
+	Instances->RegisterComponent();
+	Archetype.Instances = Instances;
+
+	return Archetypes.Num() - 1;
+}
+
+void UStrikesProjectileBatchSubsystem::Spawn(const TSubclassOf<AStrikesProjectile> ProjectileClass,
+                                             const FVector& Location, const FRotator& Rotation,
+                                             const bool bAsyncCollision, const float TimeOffset)
+{
+	if (ProjectileClass == nullptr)
+	{
+		return;
+	}
+
+	const int32 Index = FindOrAddArchetype(ProjectileClass);
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	const FStrikesBatchedProjectileArchetype& Archetype = Archetypes[Index];
+	const FVector Velocity = Rotation.Vector() * Archetype.InitialSpeed;
+
+	PosX.Add(Location.X);
+	PosY.Add(Location.Y);
+	PosZ.Add(Location.Z);
+	VelX.Add(Velocity.X);
+	VelY.Add(Velocity.Y);
+	VelZ.Add(Velocity.Z);
+	GravityZ.Add(Archetype.GravityZ);
+	Life.Add(Archetype.LifeSpan - TimeOffset);
+	ArchetypeIndex.Add(static_cast<uint8>(Index));
+	bStopped.Add(false);
+	bAsync.Add(bAsyncCollision);
+	CarryTime.Add(FMath::Max(TimeOffset, 0.f));
+	SweepHandle.AddDefaulted();
+	SweepStart.Add(Location);
+	SweepTime.Add(0.f);
+}
+
+void UStrikesProjectileBatchSubsystem::Reset()
+{
+	PosX.Reset();
+	PosY.Reset();
+	PosZ.Reset();
+	VelX.Reset();
+	VelY.Reset();
+	VelZ.Reset();
+	GravityZ.Reset();
+	Life.Reset();
+	ArchetypeIndex.Reset();
+	bStopped.Reset();
+	bAsync.Reset();
+	CarryTime.Reset();
+	SweepHandle.Reset();
+	SweepStart.Reset();
+	SweepTime.Reset();
+
+	UpdateInstances();
+}
+
+void UStrikesProjectileBatchSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!bCollisionParamsCached)
+	{
+		AStrikesProjectile::GetCollisionChannelAndResponse(Channel, ResponseParams);
+		bCollisionParamsCached = true;
+	}
+
+	ConsumeAsyncSweeps();
+	Integrate(DeltaTime);
+	ResolveCollisions(DeltaTime);
+	RemoveExpired();
+	UpdateInstances();
+
+	SET_DWORD_STAT(STAT_StrikesLiveBatchedProjectiles, Life.Num());
+}
+
+void UStrikesProjectileBatchSubsystem::Integrate(const float DeltaTime)
+{
+	const int32 Num = Life.Num();
+
+	EndX.SetNumUninitialized(Num, EAllowShrinking::No);
+	EndY.SetNumUninitialized(Num, EAllowShrinking::No);
+	EndZ.SetNumUninitialized(Num, EAllowShrinking::No);
+	StepTime.SetNumUninitialized(Num, EAllowShrinking::No);
+
+	// Plain loops over contiguous arrays so the compiler can vectorise them
+
+	for (int32 i = 0; i < Num; ++i)
+	{
+		Life[i] -= DeltaTime;
+	}
+
+	for (int32 i = 0; i < Num; ++i)
+	{
+		// Same move as UProjectileMovementComponent::ComputeMoveDelta: v*t + 1/2*g*t^2
+		const float Dt = DeltaTime + CarryTime[i];
+		EndX[i] = PosX[i] + VelX[i] * Dt;
+		EndY[i] = PosY[i] + VelY[i] * Dt;
+		EndZ[i] = PosZ[i] + VelZ[i] * Dt + GravityZ[i] * 0.5 * Dt * Dt;
+		VelZ[i] += GravityZ[i] * Dt;
+		StepTime[i] = Dt;
+		CarryTime[i] = 0.f;
+	}
+}
+
+void UStrikesProjectileBatchSubsystem::ResolveCollisions(const float DeltaTime)
+{
+	// The tolerance is given for a 60 fps frame and grows with longer frames
+	constexpr float ToleranceFrameTime = 1.f / 60.f;
+	const float Tolerance = AsyncPositionTolerance * FMath::Max(DeltaTime / ToleranceFrameTime, 1.f);
+
+	// One serial pass over the arrays: the gain over projectile actors is no component tick or move per shot,
+	// not fewer scene queries
+	const int32 Num = Life.Num();
+	for (int32 i = 0; i < Num; ++i)
+	{
+		if (Life[i] <= 0.f || bStopped[i])
+		{
+			continue;
+		}
+
+		const FVector Start(PosX[i], PosY[i], PosZ[i]);
+		const FVector End(EndX[i], EndY[i], EndZ[i]);
+
+		// Only take the async path when the one-frame overshoot stays within tolerance
+		if (bAsync[i] && FVector::DistSquared(Start, End) <= FMath::Square(Tolerance))
+		{
+			SweepAsync(i);
+		}
+		else
+		{
+			SweepSync(i, Start, End, StepTime[i]);
+		}
+	}
+}
+
+void UStrikesProjectileBatchSubsystem::SweepSync(const int32 Index, const FVector& Start, const FVector& End,
+                                                 const float StepTime)
+{
+	UWorld* const World = GetWorld();
+	const FStrikesBatchedProjectileArchetype& Archetype = Archetypes[ArchetypeIndex[Index]];
+	const FCollisionShape Shape = FCollisionShape::MakeSphere(Archetype.Radius);
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(StrikesBatchedProjectile), false);
+
+	FVector Location = Start;
+	FVector MoveEnd = End;
+	FVector Velocity(VelX[Index], VelY[Index], VelZ[Index]);
+	float RemainingTime = StepTime;
+
+	for (int32 Iteration = 0; Iteration < MaxSimulationIterations; ++Iteration)
+	{
+		FHitResult Hit;
+		if (!World->SweepSingleByChannel(Hit, Location, MoveEnd, FQuat::Identity, Channel, Shape, QueryParams,
+		                                 ResponseParams))
+		{
+			Location = MoveEnd;
+			break;
+		}
+
+		Location = Hit.Location;
+		RemainingTime *= 1.f - Hit.Time;
+
+		if (!HandleBlockingHit(Index, Hit, Velocity))
+		{
+			break;
+		}
+
+		MoveEnd = Location + Velocity * RemainingTime;
+	}
+
+	Velocity = Velocity.GetClampedToMaxSize(Archetype.MaxSpeed);
+
+	PosX[Index] = Location.X;
+	PosY[Index] = Location.Y;
+	PosZ[Index] = Location.Z;
+	VelX[Index] = Velocity.X;
+	VelY[Index] = Velocity.Y;
+	VelZ[Index] = Velocity.Z;
+}
+
+void UStrikesProjectileBatchSubsystem::SweepAsync(const int32 Index)
+{
+	const FStrikesBatchedProjectileArchetype& Archetype = Archetypes[ArchetypeIndex[Index]];
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(StrikesBatchedProjectileAsync), false);
+
+	const FVector Start(PosX[Index], PosY[Index], PosZ[Index]);
+	const FVector End(EndX[Index], EndY[Index], EndZ[Index]);
+
+	SweepHandle[Index] = GetWorld()->AsyncSweepByChannel(
+		EAsyncTraceType::Single,
+		Start,
+		End,
+		FQuat::Identity,
+		Channel,
+		FCollisionShape::MakeSphere(Archetype.Radius),
+		QueryParams,
+		ResponseParams
+	);
+	SweepStart[Index] = Start;
+	SweepTime[Index] = StepTime[Index];
+
+	// Move optimistically; ConsumeAsyncSweeps pulls the projectile back next frame if the sweep was blocked
+	const FVector Velocity = FVector(VelX[Index], VelY[Index], VelZ[Index]).GetClampedToMaxSize(Archetype.MaxSpeed);
+	PosX[Index] = End.X;
+	PosY[Index] = End.Y;
+	PosZ[Index] = End.Z;
+	VelX[Index] = Velocity.X;
+	VelY[Index] = Velocity.Y;
+	VelZ[Index] = Velocity.Z;
+}
+
+void UStrikesProjectileBatchSubsystem::ConsumeAsyncSweeps()
+{
+	UWorld* const World = GetWorld();
+
+	const int32 Num = Life.Num();
+	for (int32 i = 0; i < Num; ++i)
+	{
+		if (!SweepHandle[i].IsValid())
+		{
+			continue;
+		}
+
+		FTraceDatum Datum;
+		const bool bHasResult = World->QueryTraceData(SweepHandle[i], Datum);
+		SweepHandle[i] = FTraceHandle();
+
+		if (Life[i] <= 0.f)
+		{
+			continue;
+		}
+
+		if (!bHasResult)
+		{
+			// The result was lost, e.g. the trace data was recycled; redo last frame's move synchronously
+			// from where it started, so the projectile can't pass through what the async sweep would have hit
+			SweepSync(i, SweepStart[i], FVector(PosX[i], PosY[i], PosZ[i]), SweepTime[i]);
+			continue;
+		}
+
+		const FHitResult* Hit = Datum.OutHits.FindByPredicate([](const FHitResult& Result)
+		{
+			return Result.bBlockingHit;
+		});
+
+		if (Hit == nullptr)
+		{
+			continue;
+		}
+
+		// Rewind to the impact point and resolve the hit as the synchronous path would have
+		FVector Velocity(VelX[i], VelY[i], VelZ[i]);
+		PosX[i] = Hit->Location.X;
+		PosY[i] = Hit->Location.Y;
+		PosZ[i] = Hit->Location.Z;
+
+		const bool bKeepMoving = HandleBlockingHit(i, *Hit, Velocity);
+
+		VelX[i] = Velocity.X;
+		VelY[i] = Velocity.Y;
+		VelZ[i] = Velocity.Z;
+
+		// Compensate for the frame of latency: the part of last frame's step after the impact
+		// is simulated with the bounced velocity on top of this frame's delta
+		CarryTime[i] = bKeepMoving ? SweepTime[i] * (1.f - Hit->Time) : 0.f;
+	}
+}
+
+bool UStrikesProjectileBatchSubsystem::HandleBlockingHit(const int32 Index, const FHitResult& Hit, FVector& Velocity)
+{
+	const FStrikesBatchedProjectileArchetype& Archetype = Archetypes[ArchetypeIndex[Index]];
+
+	// Same rule as AStrikesProjectile::OnHit: push physics bodies and stop
+	UPrimitiveComponent* OtherComp = Hit.GetComponent();
+	if (Hit.GetActor() != nullptr && OtherComp != nullptr && OtherComp->IsSimulatingPhysics())
+	{
+		// Clients only simulate projectiles for show; the server pushes the body and replicates it
+		if (GetWorld()->GetNetMode() != NM_Client)
+		{
+			OtherComp->AddImpulseAtLocation(Velocity * 100.0f, Hit.Location);
+			INC_DWORD_STAT(STAT_StrikesHits);
+		}
+		Life[Index] = 0.f;
+		return false;
+	}
+
+	if (Archetype.bShouldBounce)
+	{
+		// Same response as UProjectileMovementComponent::ComputeBounceDelta without angle-dependent friction
+		const FVector Normal = Hit.Normal;
+		const double VDotNormal = FVector::DotProduct(Velocity, Normal);
+		const FVector ProjectedNormal = Normal * -FMath::Min(VDotNormal, 0.0);
+
+		Velocity += ProjectedNormal;
+		Velocity *= FMath::Clamp(1.f - Archetype.Friction, 0.f, 1.f);
+		Velocity += ProjectedNormal * FMath::Max(Archetype.Bounciness, 0.f);
+	}
+
+	if (!Archetype.bShouldBounce || Velocity.SizeSquared() < FMath::Square(Archetype.BounceStopSpeed))
+	{
+		// Came to rest; stays in place until its lifetime runs out
+		Velocity = FVector::ZeroVector;
+		GravityZ[Index] = 0.0;
+		bStopped[Index] = true;
+		return false;
+	}
+
+	return true;
+}
+
+void UStrikesProjectileBatchSubsystem::RemoveExpired()
+{
+	for (int32 i = Life.Num() - 1; i >= 0; --i)
+	{
+		if (Life[i] <= 0.f)
+		{
+			RemoveAtSwap(i);
+		}
+	}
+}
+
+void UStrikesProjectileBatchSubsystem::RemoveAtSwap(const int32 Index)
+{
+	PosX.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	PosY.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	PosZ.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	VelX.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	VelY.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	VelZ.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	GravityZ.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Life.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	ArchetypeIndex.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	bStopped.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	bAsync.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	CarryTime.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	SweepHandle.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	SweepStart.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	SweepTime.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void UStrikesProjectileBatchSubsystem::UpdateInstances()
+{
+	InstanceTransforms.SetNum(Archetypes.Num());
+	for (TArray<FTransform>& Transforms : InstanceTransforms)
+	{
+		Transforms.Reset();
+	}
+
+	const FVector Scale(ProjectileMeshScale);
+	for (int32 i = 0; i < Life.Num(); ++i)
+	{
+		// Rotation follows velocity, as with bRotationFollowsVelocity
+		const FVector Velocity(VelX[i], VelY[i], VelZ[i]);
+		InstanceTransforms[ArchetypeIndex[i]].Emplace(Velocity.Rotation(), FVector(PosX[i], PosY[i], PosZ[i]), Scale);
+	}
+
+	for (int32 Index = 0; Index < Archetypes.Num(); ++Index)
+	{
+		UInstancedStaticMeshComponent* Instances = Archetypes[Index].Instances;
+		if (Instances == nullptr)
+		{
+			continue;
+		}
+
+		const TArray<FTransform>& Transforms = InstanceTransforms[Index];
+		const int32 CurrentCount = Instances->GetInstanceCount();
+
+		// Grow or shrink the instance list, then overwrite every transform in one batch
+		if (CurrentCount < Transforms.Num())
+		{
+			AddedInstances.Reset();
+			AddedInstances.Append(Transforms.GetData() + CurrentCount, Transforms.Num() - CurrentCount);
+			Instances->AddInstances(AddedInstances, false, true);
+		}
+		else if (CurrentCount > Transforms.Num())
+		{
+			RemovedInstances.Reset();
+			for (int32 InstanceIndex = Transforms.Num(); InstanceIndex < CurrentCount; ++InstanceIndex)
+			{
+				RemovedInstances.Add(InstanceIndex);
+			}
+			Instances->RemoveInstances(RemovedInstances);
+		}
+
+		if (Transforms.Num() > 0)
+		{
+			Instances->BatchUpdateInstancesTransforms(0, Transforms, true, true, false);
+		}
+	}
+}
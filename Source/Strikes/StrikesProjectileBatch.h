@@ -0,0 +1,200 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "StrikesProjectileBatch.generated.h"
+
+class AStrikesProjectile;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+/**
+ * Movement settings shared by every batched projectile of one projectile class.
+ * Values are read from the class defaults so batched shots behave like AStrikesProjectile.
+ */
+USTRUCT()
+struct FStrikesBatchedProjectileArchetype
+{
+	GENERATED_BODY()
+
+	/** Projectile class the settings were read from */
+	UPROPERTY()
+	TSubclassOf<AStrikesProjectile> ProjectileClass;
+
+	/** Instanced mesh that draws every projectile of this archetype */
+	UPROPERTY()
+	UInstancedStaticMeshComponent* Instances = nullptr;
+
+	float Radius = 5.f;
+	float InitialSpeed = 3000.f;
+	float MaxSpeed = 3000.f;
+	float GravityZ = 0.f;
+	float Bounciness = 0.6f;
+	float Friction = 0.2f;
+	float BounceStopSpeed = 5.f;
+	float LifeSpan = 3.f;
+	bool bShouldBounce = true;
+};
+
+/**
+ * Simulates large numbers of projectiles without spawning an actor per shot.
+ * State is kept as structure-of-arrays and integrated in one pass per frame. Collision is not batched by the physics
+ * scene: moving projectiles are swept one after another using the "Projectile" collision profile, either with a
+ * blocking sweep each or, for async projectiles, by queuing every sweep through the async trace API and reading the
+ * results next frame. Projectiles are drawn through one instanced mesh per projectile class.
+ */
+UCLASS(config=Game)
+class STRIKES_API UStrikesProjectileBatchSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Mesh used to draw batched projectiles */
+	UPROPERTY(Config, EditAnywhere, Category="Projectile")
+	TSoftObjectPtr<UStaticMesh> ProjectileMesh;
+
+	/** Scale applied to ProjectileMesh instances */
+	UPROPERTY(Config, EditAnywhere, Category="Projectile")
+	float ProjectileMeshScale = 1.f;
+
+	/** Maximum number of sweeps per projectile per frame when bouncing */
+	UPROPERTY(Config, EditAnywhere, Category="Projectile")
+	int32 MaxSimulationIterations = 4;
+
+	/**
+	 * Largest distance an async-swept projectile may travel in a 60 fps frame, in uu.
+	 * The result of an async sweep arrives a frame late, so a projectile can be drawn up to one step past its impact point
+	 * before it is pulled back. The tolerance grows with longer frames, whose steps are drawn that far apart anyway, so
+	 * only projectiles faster than the tolerance allows are swept synchronously, whatever the frame rate.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Projectile")
+	float AsyncPositionTolerance = 64.f;
+
+	/**
+	 * Launches a batched projectile.
+	 *
+	 * @param ProjectileClass Class whose defaults define speed, bounce and lifetime.
+	 * @param Location World location to launch from.
+	 * @param Rotation Launch rotation; the projectile flies along its forward vector.
+	 * @param bAsyncCollision If true, the projectile's sweeps go through the async trace API and are resolved a frame later.
+	 * @param TimeOffset Seconds the projectile has already been flying; simulated on top of the next frame.
+	 */
+	void Spawn(TSubclassOf<AStrikesProjectile> ProjectileClass, const FVector& Location, const FRotator& Rotation,
+	           bool bAsyncCollision = false, float TimeOffset = 0.f);
+
+	/** Removes every batched projectile */
+	void Reset();
+
+	/** Number of batched projectiles currently in flight */
+	UFUNCTION(BlueprintPure, Category="Projectile")
+	int32 GetNumProjectiles() const { return Life.Num(); }
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	// End of FTickableGameObject interface
+
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Returns the archetype index for the class, creating it on first use */
+	int32 FindOrAddArchetype(TSubclassOf<AStrikesProjectile> ProjectileClass);
+
+	/** Advances positions, velocities and lifetimes of every projectile */
+	void Integrate(float DeltaTime);
+
+	/**
+	 * Walks the projectile arrays once and sweeps every moving projectile from its current to its predicted position.
+	 * Synchronous sweeps run serially inside the loop; async ones are only queued.
+	 */
+	void ResolveCollisions(float DeltaTime);
+
+	/** Applies the async sweep results requested last frame, pulling projectiles back to their impact points */
+	void ConsumeAsyncSweeps();
+
+	/**
+	 * Sweeps the projectile at Index synchronously, bouncing up to MaxSimulationIterations times.
+	 *
+	 * @param Index Projectile index.
+	 * @param Start Location the move starts from.
+	 * @param End Location the move ends at if nothing is hit.
+	 * @param StepTime Seconds the move covers, including time carried over from an async impact.
+	 */
+	void SweepSync(int32 Index, const FVector& Start, const FVector& End, float StepTime);
+
+	/** Requests an async sweep for this frame's move of the projectile at Index and moves it optimistically */
+	void SweepAsync(int32 Index);
+
+	/**
+	 * Applies a blocking hit to the projectile at Index: pushes physics bodies, or bounces off everything else.
+	 *
+	 * @param Index Projectile index.
+	 * @param Hit The blocking hit.
+	 * @param Velocity Velocity at the time of the hit, updated with the bounce.
+	 * @return True if the projectile keeps moving.
+	 */
+	bool HandleBlockingHit(int32 Index, const FHitResult& Hit, FVector& Velocity);
+
+	/** Removes expired projectiles, keeping the arrays dense */
+	void RemoveExpired();
+
+	/** Pushes positions to the instanced meshes */
+	void UpdateInstances();
+
+	/** Removes the projectile at Index by swapping the last one into its place */
+	void RemoveAtSwap(int32 Index);
+
+	/** Per-class movement settings and meshes */
+	UPROPERTY()
+	TArray<FStrikesBatchedProjectileArchetype> Archetypes;
+
+	/** Actor owning the instanced mesh components */
+	UPROPERTY()
+	AActor* RenderActor = nullptr;
+
+	// Projectile state, one entry per projectile in every array
+
+	TArray<double> PosX;
+	TArray<double> PosY;
+	TArray<double> PosZ;
+	TArray<double> VelX;
+	TArray<double> VelY;
+	TArray<double> VelZ;
+	TArray<double> GravityZ;
+	TArray<float> Life;
+	TArray<uint8> ArchetypeIndex;
+	TArray<bool> bStopped;
+	TArray<bool> bAsync;
+
+	// Time left over from an async impact, simulated on top of the next frame's delta
+	TArray<float> CarryTime;
+
+	// Pending async sweep of each projectile, where it starts and the time step it covers, to redo it synchronously
+	// if its result is lost
+	TArray<FTraceHandle> SweepHandle;
+	TArray<FVector> SweepStart;
+	TArray<float> SweepTime;
+
+	// Predicted end of this frame's move and the time it covers, filled by Integrate
+	TArray<double> EndX;
+	TArray<double> EndY;
+	TArray<double> EndZ;
+	TArray<float> StepTime;
+
+	// Instance transforms of each archetype and instances to remove, kept between frames to reuse their memory
+	TArray<TArray<FTransform>> InstanceTransforms;
+	TArray<FTransform> AddedInstances;
+	TArray<int32> RemovedInstances;
+
+	/** Collision settings of the "Projectile" profile, read on first use */
+	ECollisionChannel Channel = ECC_GameTraceChannel1;
+	FCollisionResponseParams ResponseParams;
+	bool bCollisionParamsCached = false;
+};
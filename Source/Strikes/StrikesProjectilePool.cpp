@@ -0,0 +1,162 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrikesProjectilePool.h"
+#include "StrikesProjectile.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+DEFINE_LOG_CATEGORY(LogStrikesProjectilePool);
+
+bool UStrikesProjectilePoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// Only game worlds fire projectiles
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UStrikesProjectilePoolSubsystem::Deinitialize()
+{
+	// Report the counters so the pool can be sized from real sessions
+	UE_LOG(LogStrikesProjectilePool, Log, TEXT("Projectile pool: %d hits, %d misses, %d overflows"),
+	       HitCount, MissCount, OverflowCount);
+
+	Buckets.Empty();
+
+	Super::Deinitialize();
+}
+
+void UStrikesProjectilePoolSubsystem::Prewarm(const TSubclassOf<AStrikesProjectile> ProjectileClass)
+{
+	if (!bEnabled || ProjectileClass == nullptr)
+	{
+		return;
+	}
+
+	FStrikesProjectilePoolBucket& Bucket = Buckets.FindOrAdd(ProjectileClass);
+	const int32 TargetCount = FMath::Min(PrewarmCount, MaxPoolSize);
+
+	while (Bucket.NumAllocated < TargetCount)
+	{
+		AStrikesProjectile* Projectile = CreatePooledProjectile(ProjectileClass, Bucket);
+		if (Projectile == nullptr)
+		{
+			break;
+		}
+
+		Bucket.Free.Add(Projectile);
+	}
+}
+
+AStrikesProjectile* UStrikesProjectilePoolSubsystem::Acquire(const TSubclassOf<AStrikesProjectile> ProjectileClass,
+                                                             const FVector& Location, const FRotator& Rotation)
+{
+	UWorld* const World = GetWorld();
+	if (World == nullptr || ProjectileClass == nullptr)
+	{
+		return nullptr;
+	}
+
+	FStrikesProjectilePoolBucket& Bucket = Buckets.FindOrAdd(ProjectileClass);
+	AStrikesProjectile* Projectile = nullptr;
+
+	// Skip entries that were destroyed behind our back (e.g. by a level streaming out)
+	while (Bucket.Free.Num() > 0 && Projectile == nullptr)
+	{
+		Projectile = Bucket.Free.Pop(EAllowShrinking::No);
+		if (!IsValid(Projectile))
+		{
+			Projectile = nullptr;
+			--Bucket.NumAllocated;
+		}
+	}
+
+	if (Projectile != nullptr)
+	{
+		++HitCount;
+	}
+	else if (Bucket.NumAllocated < MaxPoolSize)
+	{
+		++MissCount;
+		Projectile = CreatePooledProjectile(ProjectileClass, Bucket);
+	}
+	else
+	{
+		++OverflowCount;
+
+		// The pool is exhausted, so spawn a regular projectile that destroys itself as before
+		FActorSpawnParameters ActorSpawnParams;
+		ActorSpawnParams.SpawnCollisionHandlingOverride =
+			ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding;
+
+		return World->SpawnActor<AStrikesProjectile>(ProjectileClass, Location, Rotation, ActorSpawnParams);
+	}
+
+	if (Projectile != nullptr)
+	{
+		Projectile->ActivatePooled(Location, Rotation);
+	}
+
+	return Projectile;
+}
+
+void UStrikesProjectilePoolSubsystem::Release(AStrikesProjectile* Projectile)
+{
+	if (!IsValid(Projectile) || !Projectile->IsPooled())
+	{
+		return;
+	}
+
+	Projectile->DeactivatePooled();
+
+	FStrikesProjectilePoolBucket& Bucket = Buckets.FindOrAdd(Projectile->GetClass());
+	Bucket.Free.AddUnique(Projectile);
+}
+
+void UStrikesProjectilePoolSubsystem::ReleaseAll()
+{
+	for (TActorIterator<AStrikesProjectile> It(GetWorld()); It; ++It)
+	{
+		AStrikesProjectile* Projectile = *It;
+		if (Projectile->IsPooled())
+		{
+			Release(Projectile);
+		}
+		else
+		{
+			Projectile->Destroy();
+		}
+	}
+}
+
+AStrikesProjectile* UStrikesProjectilePoolSubsystem::CreatePooledProjectile(
+	const TSubclassOf<AStrikesProjectile> ProjectileClass,
+	FStrikesProjectilePoolBucket& Bucket)
+{
+	UWorld* const World = GetWorld();
+	if (World == nullptr)
+	{
+		return nullptr;
+	}
+
+	// Spawn deferred so collision is off before the projectile ever touches the scene
+	AStrikesProjectile* Projectile = World->SpawnActorDeferred<AStrikesProjectile>(
+		ProjectileClass,
+		FTransform::Identity,
+		nullptr,
+		nullptr,
+		ESpawnActorCollisionHandlingMethod::AlwaysSpawn
+	);
+
+	if (Projectile == nullptr)
+	{
+		return nullptr;
+	}
+
+	Projectile->SetPool(this);
+	Projectile->SetActorEnableCollision(false);
+	Projectile->FinishSpawning(FTransform::Identity);
+	Projectile->DeactivatePooled();
+
+	++Bucket.NumAllocated;
+
+	return Projectile;
+}
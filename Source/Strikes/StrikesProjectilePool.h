@@ -0,0 +1,110 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "StrikesProjectilePool.generated.h"
+
+class AStrikesProjectile;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogStrikesProjectilePool, Log, All);
+
+/**
+ * Free list of pooled projectiles for a single projectile class.
+ */
+USTRUCT()
+struct FStrikesProjectilePoolBucket
+{
+	GENERATED_BODY()
+
+	/** Projectiles that are parked and ready to be handed out. */
+	UPROPERTY()
+	TArray<AStrikesProjectile*> Free;
+
+	/** Total number of pooled projectiles created for this class (free + in flight). */
+	int32 NumAllocated = 0;
+};
+
+/**
+ * World subsystem that recycles projectile actors instead of spawning and destroying one per shot.
+ * Projectiles are pre-warmed when a weapon is attached, handed out from UTP_WeaponComponent::Fire
+ * and returned to the pool on hit or when their lifetime expires.
+ */
+UCLASS(config=Game)
+class STRIKES_API UStrikesProjectilePoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Whether weapons should take projectiles from the pool at all. */
+	UPROPERTY(Config, EditAnywhere, Category="Pool")
+	bool bEnabled = true;
+
+	/** Number of projectiles created up front for each projectile class. */
+	UPROPERTY(Config, EditAnywhere, Category="Pool")
+	int32 PrewarmCount = 32;
+
+	/** Upper bound of pooled projectiles per class; requests beyond it fall back to a regular spawn. */
+	UPROPERTY(Config, EditAnywhere, Category="Pool")
+	int32 MaxPoolSize = 128;
+
+	virtual void Deinitialize() override;
+
+	/**
+	 * Creates pooled projectiles of the given class until PrewarmCount of them exist.
+	 *
+	 * @param ProjectileClass The projectile class to pre-warm.
+	 */
+	void Prewarm(TSubclassOf<AStrikesProjectile> ProjectileClass);
+
+	/**
+	 * Hands out a projectile placed at the given transform and launched along its rotation.
+	 * Reuses a parked projectile when possible, otherwise grows the pool or spawns an unpooled projectile.
+	 *
+	 * @param ProjectileClass The projectile class to hand out.
+	 * @param Location World location to launch from.
+	 * @param Rotation Launch rotation; the projectile flies along its forward vector.
+	 * @return The launched projectile, or nullptr if it could not be spawned.
+	 */
+	AStrikesProjectile* Acquire(TSubclassOf<AStrikesProjectile> ProjectileClass, const FVector& Location,
+	                            const FRotator& Rotation);
+
+	/**
+	 * Parks a pooled projectile so it can be handed out again.
+	 *
+	 * @param Projectile The projectile to return. Must have been created by this pool.
+	 */
+	void Release(AStrikesProjectile* Projectile);
+
+	/** Returns every pooled projectile in the world to the pool and destroys unpooled ones. */
+	void ReleaseAll();
+
+	/** Number of requests served by a parked projectile. */
+	UFUNCTION(BlueprintPure, Category="Pool")
+	int32 GetHitCount() const { return HitCount; }
+
+	/** Number of requests that had to grow the pool. */
+	UFUNCTION(BlueprintPure, Category="Pool")
+	int32 GetMissCount() const { return MissCount; }
+
+	/** Number of requests that exceeded MaxPoolSize and were spawned outside the pool. */
+	UFUNCTION(BlueprintPure, Category="Pool")
+	int32 GetOverflowCount() const { return OverflowCount; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Spawns a new parked projectile for the given bucket. */
+	AStrikesProjectile* CreatePooledProjectile(TSubclassOf<AStrikesProjectile> ProjectileClass,
+	                                           FStrikesProjectilePoolBucket& Bucket);
+
+	/** Free lists keyed by projectile class. */
+	UPROPERTY()
+	TMap<TSubclassOf<AStrikesProjectile>, FStrikesProjectilePoolBucket> Buckets;
+
+	int32 HitCount = 0;
+	int32 MissCount = 0;
+	int32 OverflowCount = 0;
+};
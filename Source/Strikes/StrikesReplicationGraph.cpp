@@ -0,0 +1,188 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrikesReplicationGraph.h"
+#include "CampFire.h"
+#include "MedKit.h"
+#include "StrikesCharacter.h"
+#include "StrikesProjectile.h"
+#include "TP_PickUpComponent.h"
+#include "Engine/NetDriver.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "Net/UnrealNetwork.h"
+
+void UStrikesReplicationGraphNode_AlwaysRelevant_ForConnection::GatherActorListsForConnection(
+	const FConnectionGatherActorListParameters& Params)
+{
+	Super::GatherActorListsForConnection(Params);
+
+	OwnerActors.Reset();
+	for (const FNetViewer& Viewer : Params.Viewers)
+	{
+		OwnerActors.ConditionalAdd(Viewer.InViewer);
+		OwnerActors.ConditionalAdd(Viewer.ViewTarget);
+
+		// The player's own character and what it carries, wherever it is in the grid
+		if (const APlayerController* PlayerController = Cast<APlayerController>(Viewer.InViewer))
+		{
+			if (APawn* Pawn = PlayerController->GetPawn())
+			{
+				OwnerActors.ConditionalAdd(Pawn);
+
+				Pawn->GetAttachedActors(AttachedActors, true, true);
+				for (AActor* Attached : AttachedActors)
+				{
+					if (Attached->GetIsReplicated())
+					{
+						OwnerActors.ConditionalAdd(Attached);
+					}
+				}
+			}
+		}
+	}
+
+	if (OwnerActors.Num() > 0)
+	{
+		Params.OutGatheredReplicationLists.AddReplicationActorList(OwnerActors);
+	}
+}
+
+void UStrikesReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	const float TickRate = NetDriver->GetNetServerMaxTickRate();
+	const auto FramesFor = [TickRate](const float Seconds)
+	{
+		return static_cast<uint32>(FMath::Max(FMath::RoundToInt(Seconds * TickRate), 1));
+	};
+
+	// Campfires, medkits and pickups rarely change, so only check them every StaticActorUpdateInterval
+	StaticActorInfo.ReplicationPeriodFrame = FramesFor(StaticActorUpdateInterval);
+	StaticActorInfo.SetCullDistanceSquared(FMath::Square(StaticActorCullDistance));
+	GlobalActorReplicationInfoMap.SetClassInfo(ACampFire::StaticClass(), StaticActorInfo);
+	GlobalActorReplicationInfoMap.SetClassInfo(AMedKit::StaticClass(), StaticActorInfo);
+
+	// Projectiles fly fast and die young: update every frame, only nearby, and drop their channel soon after
+	FClassReplicationInfo ProjectileInfo;
+	ProjectileInfo.ReplicationPeriodFrame = 1;
+	ProjectileInfo.SetCullDistanceSquared(FMath::Square(ProjectileCullDistance));
+	ProjectileInfo.ActorChannelFrameTimeout = 1;
+	GlobalActorReplicationInfoMap.SetClassInfo(AStrikesProjectile::StaticClass(), ProjectileInfo);
+
+	FClassReplicationInfo CharacterInfo;
+	CharacterInfo.ReplicationPeriodFrame = 1;
+	CharacterInfo.SetCullDistanceSquared(FMath::Square(CharacterCullDistance));
+	GlobalActorReplicationInfoMap.SetClassInfo(AStrikesCharacter::StaticClass(), CharacterInfo);
+}
+
+void UStrikesReplicationGraph::InitGlobalGraphNodes()
+{
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = GridCellSize;
+	GridNode->SpatialBias = SpatialBias;
+	AddGlobalGraphNode(GridNode);
+
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+}
+
+void UStrikesReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+	Super::InitConnectionGraphNodes(RepGraphConnection);
+
+	UStrikesReplicationGraphNode_AlwaysRelevant_ForConnection* OwnerNode =
+		CreateNewNode<UStrikesReplicationGraphNode_AlwaysRelevant_ForConnection>();
+	AddConnectionGraphNode(OwnerNode, RepGraphConnection);
+}
+
+UStrikesReplicationGraph::ERouting UStrikesReplicationGraph::GetRouting(const AActor* Actor) const
+{
+	// Controllers and other owner-only actors come from the per-connection node
+	if (Actor->bOnlyRelevantToOwner || Actor->IsA<APlayerController>())
+	{
+		return ERouting::ENotRouted;
+	}
+
+	if (Actor->bAlwaysRelevant || Actor->IsA<AGameStateBase>() || Actor->IsA<APlayerState>())
+	{
+		return ERouting::EAlwaysRelevant;
+	}
+
+	if (Actor->IsA<ACampFire>() || Actor->IsA<AMedKit>())
+	{
+		return ERouting::EStatic;
+	}
+
+	// Pickups lie still until someone carries them around; pooled projectiles are dormant
+	if (Actor->IsA<AStrikesProjectile>() || Actor->FindComponentByClass<UTP_PickUpComponent>() != nullptr)
+	{
+		return ERouting::EDormancy;
+	}
+
+	return ERouting::EDynamic;
+}
+
+void UStrikesReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo,
+                                                           FGlobalActorReplicationInfo& GlobalInfo)
+{
+	AActor* Actor = ActorInfo.Actor;
+	const ERouting Routing = GetRouting(Actor);
+
+	// Pickups are Blueprint actors found by their component, so they get the static settings here
+	if (Routing == ERouting::EDormancy && !Actor->IsA<AStrikesProjectile>())
+	{
+		GlobalInfo.Settings = StaticActorInfo;
+	}
+
+	switch (Routing)
+	{
+	case ERouting::ENotRouted:
+		break;
+	case ERouting::EAlwaysRelevant:
+		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+		break;
+	case ERouting::EStatic:
+		GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+		break;
+	case ERouting::EDormancy:
+		GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+		break;
+	case ERouting::EDynamic:
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+		break;
+	}
+}
+
+void UStrikesReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	switch (GetRouting(ActorInfo.Actor))
+	{
+	case ERouting::ENotRouted:
+		break;
+	case ERouting::EAlwaysRelevant:
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+		break;
+	case ERouting::EStatic:
+		GridNode->RemoveActor_Static(ActorInfo);
+		break;
+	case ERouting::EDormancy:
+		GridNode->RemoveActor_Dormancy(ActorInfo);
+		break;
+	case ERouting::EDynamic:
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+		break;
+	}
+}
+
+int32 UStrikesReplicationGraph::ServerReplicateActors(const float DeltaSeconds)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	const int32 Result = Super::ServerReplicateActors(DeltaSeconds);
+	const double ElapsedMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+
+	// Smooth over roughly the last second of server frames
+	AverageReplicateMs = FMath::Lerp(AverageReplicateMs, ElapsedMs, 0.05);
+	return Result;
+}
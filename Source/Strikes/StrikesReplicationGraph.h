@@ -0,0 +1,110 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "StrikesReplicationGraph.generated.h"
+
+/**
+ * Per-connection node for the actors a player always needs: their controller, the pawn they view and
+ * whatever is attached to it, such as the weapon they hold.
+ */
+UCLASS()
+class STRIKES_API UStrikesReplicationGraphNode_AlwaysRelevant_ForConnection : public UReplicationGraphNode_AlwaysRelevant_ForConnection
+{
+	GENERATED_BODY()
+
+public:
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+private:
+	/** Actors gathered for the connection this frame */
+	FActorRepListRefView OwnerActors;
+
+	/** Scratch list of the actors attached to the viewed pawn */
+	TArray<AActor*> AttachedActors;
+};
+
+/**
+ * Replication graph for Strikes.
+ * Instead of testing every actor for relevancy against every connection, actors are routed once by type:
+ * - Campfires, medkits and pickups sit in the spatial grid as static actors and update rarely.
+ * - Projectiles are in the grid by dormancy: pooled ones are dormant and cost nothing, flying ones update every frame
+ *   with a short cull distance and close their channels quickly.
+ * - Characters are spatialized for everyone else and always relevant to their owner.
+ */
+UCLASS(Transient, config=Game)
+class STRIKES_API UStrikesReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	/** Edge length of a spatial grid cell in uu */
+	UPROPERTY(Config)
+	float GridCellSize = 10000.f;
+
+	/** Lowest world X and Y the grid expects; actors below it make the grid rebuild */
+	UPROPERTY(Config)
+	FVector2D SpatialBias = FVector2D(-200000.f, -200000.f);
+
+	/** Seconds between updates of campfires, medkits and idle pickups */
+	UPROPERTY(Config)
+	float StaticActorUpdateInterval = 1.f;
+
+	/** Distance in uu beyond which campfires, medkits and pickups are not replicated */
+	UPROPERTY(Config)
+	float StaticActorCullDistance = 8000.f;
+
+	/** Distance in uu beyond which projectiles are not replicated */
+	UPROPERTY(Config)
+	float ProjectileCullDistance = 6000.f;
+
+	/** Distance in uu beyond which other players' characters are not replicated */
+	UPROPERTY(Config)
+	float CharacterCullDistance = 15000.f;
+
+	/** Average time spent replicating actors per server frame, in milliseconds */
+	double GetAverageReplicateMs() const { return AverageReplicateMs; }
+
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo,
+	                                         FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual int32 ServerReplicateActors(float DeltaSeconds) override;
+
+private:
+	/** How an actor is routed into the graph */
+	enum class ERouting : uint8
+	{
+		/** Handled by the per-connection node, or not replicated through the graph */
+		ENotRouted,
+		/** Replicated to every connection */
+		EAlwaysRelevant,
+		/** In the grid, never moves */
+		EStatic,
+		/** In the grid, treated as static while dormant and dynamic while awake */
+		EDormancy,
+		/** In the grid, moves */
+		EDynamic
+	};
+
+	/** Routing of an actor, from its class and components */
+	ERouting GetRouting(const AActor* Actor) const;
+
+	/** Replication settings for campfires, medkits and pickups */
+	FClassReplicationInfo StaticActorInfo;
+
+	/** Spatial grid every routed actor goes into */
+	UPROPERTY()
+	UReplicationGraphNode_GridSpatialization2D* GridNode = nullptr;
+
+	/** Actors relevant to every connection, such as the game state */
+	UPROPERTY()
+	UReplicationGraphNode_ActorList* AlwaysRelevantNode = nullptr;
+
+	/** Exponential moving average of ServerReplicateActors time */
+	double AverageReplicateMs = 0.0;
+};
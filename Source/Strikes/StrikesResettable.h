@@ -0,0 +1,26 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "StrikesResettable.generated.h"
+
+UINTERFACE(MinimalAPI)
+class UStrikesResettable : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Implemented by actors and components that can be put back into their BeginPlay state
+ * by UStrikesLevelResetSubsystem without reloading the map.
+ */
+class STRIKES_API IStrikesResettable
+{
+	GENERATED_BODY()
+
+public:
+	/** Restores the state captured when the object began play. */
+	virtual void RestoreInitialState() = 0;
+};
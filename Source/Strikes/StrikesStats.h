@@ -0,0 +1,129 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Trace/Trace.h"
+
+/** Stats for Strikes gameplay code, shown with `stat Strikes`. */
+DECLARE_STATS_GROUP(TEXT("Strikes"), STATGROUP_Strikes, STATCAT_Advanced);
+
+/** Timer manager SetTimer/ClearTimer calls made by gameplay code this frame. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Timer Operations"), STAT_StrikesTimerOps, STATGROUP_Strikes, STRIKES_API);
+
+/** Timer manager calls the timer-based cooldown windows would have made this frame, for comparison with Timer Operations. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Timer Operations Avoided"), STAT_StrikesTimerOpsAvoided, STATGROUP_Strikes, STRIKES_API);
+
+/** Timer Operations over the last second. */
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Timer Operations/s"), STAT_StrikesTimerOpsPerSecond, STATGROUP_Strikes, STRIKES_API);
+
+/** Timer Operations Avoided over the last second. */
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Timer Operations Avoided/s"), STAT_StrikesTimerOpsAvoidedPerSecond, STATGROUP_Strikes, STRIKES_API);
+
+/** Hitscan line traces resolved this frame. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Hitscan Traces"), STAT_StrikesHitscanTraces, STATGROUP_Strikes, STRIKES_API);
+
+/** Slate paint time of the health HUD, excluding frames where it was cached. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("HUD Paint"), STAT_StrikesHUDPaint, STATGROUP_Strikes, STRIKES_API);
+
+/** Slate prepass (desired size) time of the health HUD. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("HUD Prepass"), STAT_StrikesHUDPrepass, STATGROUP_Strikes, STRIKES_API);
+
+/** Weapon shot handling, from the trigger to the spawned projectile or queued trace. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Weapon Fire"), STAT_StrikesWeaponFire, STATGROUP_Strikes, STRIKES_API);
+
+/** Actor projectile hit handling. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectile Hit"), STAT_StrikesProjectileHit, STATGROUP_Strikes, STRIKES_API);
+
+/** Campfire damage ticks. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Campfire Damage"), STAT_StrikesCampFireDamage, STATGROUP_Strikes, STRIKES_API);
+
+/** Character damage handling, including the health update it causes. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Take Damage"), STAT_StrikesTakeDamage, STATGROUP_Strikes, STRIKES_API);
+
+/** Character health updates and the notifications they broadcast. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Health"), STAT_StrikesUpdateHealth, STATGROUP_Strikes, STRIKES_API);
+
+/** Magic curve evaluation while the magic bar animates. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Set Magic Value"), STAT_StrikesSetMagicValue, STATGROUP_Strikes, STRIKES_API);
+
+/** Medkit overlap handling. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("MedKit Overlap"), STAT_StrikesMedKitOverlap, STATGROUP_Strikes, STRIKES_API);
+
+/** HUD view-model and widget creation. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("HUD Create"), STAT_StrikesHUDCreate, STATGROUP_Strikes, STRIKES_API);
+
+/** Soft reset of the level on game over, restoring every resettable object in place. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Soft Reset"), STAT_StrikesSoftReset, STATGROUP_Strikes, STRIKES_API);
+
+/** Duration of the last soft reset in ms, kept until the next one; also recorded as the SoftResetMs CSV stat. */
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Last Soft Reset (ms)"), STAT_StrikesLastSoftResetMs, STATGROUP_Strikes, STRIKES_API);
+
+/** Duration of the last map reload in ms, until the new world began play; also recorded as the LevelReloadMs CSV stat. */
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Last Level Reload (ms)"), STAT_StrikesLastLevelReloadMs, STATGROUP_Strikes, STRIKES_API);
+
+/** Per-frame loop of UStrikesAttributeSubsystem settling the magic of every character. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Attribute Settle"), STAT_StrikesAttributeSettle, STATGROUP_Strikes, STRIKES_API);
+
+/** Shots fired this frame, in any projectile mode. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Shots"), STAT_StrikesShots, STATGROUP_Strikes, STRIKES_API);
+
+/** Shots that struck a physics body or, with lag compensation, a character this frame. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Hits"), STAT_StrikesHits, STATGROUP_Strikes, STRIKES_API);
+
+/** Damage events received by characters this frame. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Damage Events"), STAT_StrikesDamageEvents, STATGROUP_Strikes, STRIKES_API);
+
+/** Medkits and weapons picked up this frame. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pickups"), STAT_StrikesPickups, STATGROUP_Strikes, STRIKES_API);
+
+/** Projectile actors currently flying; pooled projectiles waiting in the pool are not counted. */
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Projectiles"), STAT_StrikesLiveProjectiles, STATGROUP_Strikes, STRIKES_API);
+
+/** Projectiles currently simulated by the batch subsystem. */
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Batched Projectiles"), STAT_StrikesLiveBatchedProjectiles, STATGROUP_Strikes, STRIKES_API);
+
+/** CSV profiler category for Strikes gameplay, captured with -csvCaptureFrames=N or `CsvProfile Start`. */
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(STRIKES_API, Strikes);
+
+/** Gameplay events counted for the Strikes CSV category and -StrikesPerfRun reports */
+enum class EStrikesFrameEvent : uint8
+{
+	EDamageEvent,
+	EHUDUpdate,
+	ETimerOp,
+	ETimerOpAvoided,
+	ENum
+};
+
+namespace StrikesFrameEvents
+{
+	/** Events counted since startup; readers diff them against their previous frame. Game thread only. */
+	extern STRIKES_API int64 Totals[static_cast<int32>(EStrikesFrameEvent::ENum)];
+
+	/** Counts events; events that also have a `stat Strikes` counter are counted with STRIKES_COUNT_EVENT */
+	inline void Add(const EStrikesFrameEvent Event, const int64 Count = 1)
+	{
+		Totals[static_cast<int32>(Event)] += Count;
+	}
+}
+
+/** Counts Count gameplay events in both the `stat Strikes` counter and the frame event totals, so the two agree. */
+#define STRIKES_COUNT_EVENT(Stat, Event, Count) \
+	do \
+	{ \
+		INC_DWORD_STAT_BY(Stat, Count); \
+		StrikesFrameEvents::Add(Event, Count); \
+	} \
+	while (false)
+
+/** Insights channel for Strikes gameplay scopes, recorded with -trace=cpu,Strikes. */
+UE_TRACE_CHANNEL_EXTERN(StrikesChannel, STRIKES_API);
+
+/** Times the enclosing scope as a `stat Strikes` cycle counter and as a CPU event on the Strikes trace channel. */
+#define STRIKES_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Stat, StrikesChannel)
@@ -0,0 +1,246 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrikesTriggerGrid.h"
+#include "StrikesCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+bool UStrikesTriggerGridSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// Only game worlds have characters walking into triggers
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UStrikesTriggerGridSubsystem::IsTickable() const
+{
+	// Nothing to test while no trigger opted in
+	return TriggerIndices.Num() > 0;
+}
+
+TStatId UStrikesTriggerGridSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UStrikesTriggerGridSubsystem, STATGROUP_Tickables);
+}
+
+FIntVector UStrikesTriggerGridSubsystem::ToCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt32(Location.X / CellSize),
+		FMath::FloorToInt32(Location.Y / CellSize),
+		FMath::FloorToInt32(Location.Z / CellSize)
+	);
+}
+
+void UStrikesTriggerGridSubsystem::RegisterBox(UObject* Trigger, const FBox& Bounds)
+{
+	Register(Trigger, Bounds, 0.f);
+}
+
+void UStrikesTriggerGridSubsystem::RegisterSphere(UObject* Trigger, const FVector& Center, const float Radius)
+{
+	Register(Trigger, FBox::BuildAABB(Center, FVector(Radius)), Radius);
+}
+
+void UStrikesTriggerGridSubsystem::Register(UObject* Trigger, const FBox& Bounds, const float SphereRadius)
+{
+	if (Trigger == nullptr || !Trigger->Implements<UStrikesGridTrigger>())
+	{
+		return;
+	}
+
+	int32 Index;
+	if (const int32* ExistingIndex = TriggerIndices.Find(Trigger))
+	{
+		// Moving an existing trigger
+		Index = *ExistingIndex;
+		RemoveFromCells(Index);
+	}
+	else
+	{
+		Index = FreeTriggers.Num() > 0 ? FreeTriggers.Pop(EAllowShrinking::No) : Triggers.AddDefaulted();
+		Triggers[Index] = FStrikesGridTriggerEntry();
+		Triggers[Index].Owner = Trigger;
+		TriggerIndices.Add(Trigger, Index);
+	}
+
+	Triggers[Index].Bounds = Bounds;
+	Triggers[Index].SphereRadius = SphereRadius;
+	AddToCells(Index);
+}
+
+void UStrikesTriggerGridSubsystem::Unregister(UObject* Trigger)
+{
+	int32 Index;
+	if (!TriggerIndices.RemoveAndCopyValue(Trigger, Index))
+	{
+		return;
+	}
+
+	RemoveFromCells(Index);
+	Triggers[Index] = FStrikesGridTriggerEntry();
+	FreeTriggers.Add(Index);
+
+	// Forget overlaps with the removed trigger so the slot starts clean when reused
+	for (auto It = Overlaps.CreateIterator(); It; ++It)
+	{
+		if (It->Key == Index)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UStrikesTriggerGridSubsystem::SetTriggerEnabled(UObject* Trigger, const bool bEnabled)
+{
+	if (const int32* Index = TriggerIndices.Find(Trigger))
+	{
+		Triggers[*Index].bEnabled = bEnabled;
+	}
+}
+
+void UStrikesTriggerGridSubsystem::AddToCells(const int32 TriggerIndex)
+{
+	const FBox& Bounds = Triggers[TriggerIndex].Bounds;
+	const FIntVector Min = ToCell(Bounds.Min);
+	const FIntVector Max = ToCell(Bounds.Max);
+
+	for (int32 X = Min.X; X <= Max.X; ++X)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+			{
+				Cells.FindOrAdd(FIntVector(X, Y, Z)).Add(TriggerIndex);
+			}
+		}
+	}
+}
+
+void UStrikesTriggerGridSubsystem::RemoveFromCells(const int32 TriggerIndex)
+{
+	const FBox& Bounds = Triggers[TriggerIndex].Bounds;
+	const FIntVector Min = ToCell(Bounds.Min);
+	const FIntVector Max = ToCell(Bounds.Max);
+
+	for (int32 X = Min.X; X <= Max.X; ++X)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+			{
+				const FIntVector Cell(X, Y, Z);
+				if (TArray<int32>* CellTriggers = Cells.Find(Cell))
+				{
+					CellTriggers->RemoveSingleSwap(TriggerIndex, EAllowShrinking::No);
+					if (CellTriggers->Num() == 0)
+					{
+						Cells.Remove(Cell);
+					}
+				}
+			}
+		}
+	}
+}
+
+void UStrikesTriggerGridSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Reset rather than rebuilt, so a steady number of overlaps doesn't allocate
+	CurrentOverlaps.Reset();
+
+	// Test every character's capsule bounds against the triggers in the cells it touches
+	for (TActorIterator<AStrikesCharacter> It(GetWorld()); It; ++It)
+	{
+		AStrikesCharacter* Character = *It;
+		const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+		if (!Character->GetActorEnableCollision())
+		{
+			continue;
+		}
+
+		const FVector Location = Character->GetActorLocation();
+		const float Radius = Capsule->GetScaledCapsuleRadius();
+		const FBox CharacterBounds = FBox::BuildAABB(
+			Location, FVector(Radius, Radius, Capsule->GetScaledCapsuleHalfHeight()));
+
+		const uint32 Query = ++QueryCounter;
+		const FIntVector Min = ToCell(CharacterBounds.Min);
+		const FIntVector Max = ToCell(CharacterBounds.Max);
+
+		for (int32 X = Min.X; X <= Max.X; ++X)
+		{
+			for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+			{
+				for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+				{
+					const TArray<int32>* CellTriggers = Cells.Find(FIntVector(X, Y, Z));
+					if (CellTriggers == nullptr)
+					{
+						continue;
+					}
+
+					for (const int32 TriggerIndex : *CellTriggers)
+					{
+						FStrikesGridTriggerEntry& Trigger = Triggers[TriggerIndex];
+						if (Trigger.LastQuery == Query || !Trigger.bEnabled)
+						{
+							continue;
+						}
+						Trigger.LastQuery = Query;
+
+						const bool bOverlaps = Trigger.SphereRadius > 0.f
+							                       ? CharacterBounds.ComputeSquaredDistanceToPoint(Trigger.Bounds.GetCenter()) <=
+							                       FMath::Square(Trigger.SphereRadius)
+							                       : CharacterBounds.Intersect(Trigger.Bounds);
+
+						if (bOverlaps)
+						{
+							CurrentOverlaps.Emplace(TriggerIndex, Character);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// Collect begin and end events before dispatching, since callbacks may register or disable triggers
+	Begins.Reset();
+	Ends.Reset();
+
+	for (const TPair<int32, TWeakObjectPtr<AStrikesCharacter>>& Overlap : CurrentOverlaps)
+	{
+		if (!Overlaps.Contains(Overlap))
+		{
+			Begins.Emplace(Triggers[Overlap.Key].Owner, Overlap.Value);
+		}
+	}
+
+	for (const TPair<int32, TWeakObjectPtr<AStrikesCharacter>>& Overlap : Overlaps)
+	{
+		if (!CurrentOverlaps.Contains(Overlap) && Triggers[Overlap.Key].bEnabled)
+		{
+			Ends.Emplace(Triggers[Overlap.Key].Owner, Overlap.Value);
+		}
+	}
+
+	// The previous overlaps become next tick's scratch set
+	Swap(Overlaps, CurrentOverlaps);
+
+	for (const auto& Event : Ends)
+	{
+		if (Event.Key.IsValid() && Event.Value.IsValid())
+		{
+			CastChecked<IStrikesGridTrigger>(Event.Key.Get())->OnGridTriggerEnd(Event.Value.Get());
+		}
+	}
+
+	for (const auto& Event : Begins)
+	{
+		if (Event.Key.IsValid() && Event.Value.IsValid())
+		{
+			CastChecked<IStrikesGridTrigger>(Event.Key.Get())->OnGridTriggerBegin(Event.Value.Get());
+		}
+	}
+}
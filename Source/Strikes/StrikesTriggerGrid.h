@@ -0,0 +1,144 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/Interface.h"
+#include "StrikesTriggerGrid.generated.h"
+
+class AStrikesCharacter;
+
+UINTERFACE(MinimalAPI)
+class UStrikesGridTrigger : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Implemented by triggers that can be driven by UStrikesTriggerGridSubsystem instead of physics overlaps.
+ */
+class STRIKES_API IStrikesGridTrigger
+{
+	GENERATED_BODY()
+
+public:
+	/** Called when a character enters the trigger. */
+	virtual void OnGridTriggerBegin(AStrikesCharacter* Character) = 0;
+
+	/** Called when a character leaves the trigger. */
+	virtual void OnGridTriggerEnd(AStrikesCharacter* Character) {}
+};
+
+/**
+ * A trigger volume stored in the grid.
+ */
+USTRUCT()
+struct FStrikesGridTriggerEntry
+{
+	GENERATED_BODY()
+
+	/** Object implementing IStrikesGridTrigger */
+	TWeakObjectPtr<UObject> Owner;
+
+	/** World-space bounds of the trigger */
+	FBox Bounds = FBox(ForceInit);
+
+	/** If greater than zero the trigger is a sphere of this radius around the bounds center, otherwise a box */
+	float SphereRadius = 0.f;
+
+	/** Disabled triggers stay in the grid but never fire */
+	bool bEnabled = true;
+
+	/** Last query that visited this trigger, to test it once per character */
+	uint32 LastQuery = 0;
+};
+
+/**
+ * Lightweight trigger system backed by a uniform spatial hash grid.
+ * Opt-in replacement for physics overlap events on campfires, medkits and pickups: triggers are registered once,
+ * and every character's capsule bounds are tested against the grid in a single pass per frame.
+ */
+UCLASS(config=Game)
+class STRIKES_API UStrikesTriggerGridSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Edge length of a grid cell in uu; should be around the size of the largest common trigger */
+	UPROPERTY(Config, EditAnywhere, Category="Trigger")
+	float CellSize = 400.f;
+
+	/**
+	 * Adds a box trigger, or moves it if already registered.
+	 *
+	 * @param Trigger Object implementing IStrikesGridTrigger.
+	 * @param Bounds World-space bounds of the trigger.
+	 */
+	void RegisterBox(UObject* Trigger, const FBox& Bounds);
+
+	/**
+	 * Adds a sphere trigger, or moves it if already registered.
+	 *
+	 * @param Trigger Object implementing IStrikesGridTrigger.
+	 * @param Center World-space center of the sphere.
+	 * @param Radius Radius of the sphere.
+	 */
+	void RegisterSphere(UObject* Trigger, const FVector& Center, float Radius);
+
+	/** Removes a trigger; characters inside it get no end callback. */
+	void Unregister(UObject* Trigger);
+
+	/**
+	 * Enables or disables a trigger without removing it from the grid.
+	 * Characters inside a disabled trigger get no end callback and enter it again once it is re-enabled.
+	 */
+	void SetTriggerEnabled(UObject* Trigger, bool bEnabled);
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	// End of FTickableGameObject interface
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Adds or moves a trigger */
+	void Register(UObject* Trigger, const FBox& Bounds, float SphereRadius);
+
+	/** Adds the trigger index to every cell its bounds touch */
+	void AddToCells(int32 TriggerIndex);
+
+	/** Removes the trigger index from every cell its bounds touch */
+	void RemoveFromCells(int32 TriggerIndex);
+
+	/** Cell coordinates containing the given location */
+	FIntVector ToCell(const FVector& Location) const;
+
+	/** All triggers; freed slots have no owner and are reused */
+	TArray<FStrikesGridTriggerEntry> Triggers;
+
+	/** Free slots in Triggers */
+	TArray<int32> FreeTriggers;
+
+	/** Trigger index of each registered object */
+	TMap<TWeakObjectPtr<UObject>, int32> TriggerIndices;
+
+	/** Trigger indices per grid cell */
+	TMap<FIntVector, TArray<int32>> Cells;
+
+	/** (trigger, character) pairs that were overlapping last frame */
+	TSet<TPair<int32, TWeakObjectPtr<AStrikesCharacter>>> Overlaps;
+
+	/** (trigger, character) pairs overlapping this frame; swapped with Overlaps and reset every tick */
+	TSet<TPair<int32, TWeakObjectPtr<AStrikesCharacter>>> CurrentOverlaps;
+
+	/** Begin and end events collected by the last tick, kept to reuse their allocations */
+	TArray<TPair<TWeakObjectPtr<UObject>, TWeakObjectPtr<AStrikesCharacter>>> Begins;
+	TArray<TPair<TWeakObjectPtr<UObject>, TWeakObjectPtr<AStrikesCharacter>>> Ends;
+
+	/** Incremented for every character query */
+	uint32 QueryCounter = 0;
+};
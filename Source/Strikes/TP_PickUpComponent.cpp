@@ -1,6 +1,9 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "TP_PickUpComponent.h"
+#include "StrikesLevelReset.h"
+#include "StrikesStats.h"
+#include "TP_WeaponComponent.h"
 
 UTP_PickUpComponent::UTP_PickUpComponent()
 {
@@ -14,18 +17,92 @@ void UTP_PickUpComponent::BeginPlay()
 
 	// Register our Overlap Event
 	OnComponentBeginOverlap.AddDynamic(this, &UTP_PickUpComponent::OnSphereBeginOverlap);
+
+	if (bUseTriggerGrid)
+	{
+		// The grid reports characters walking in, physics no longer needs to
+		SetGenerateOverlapEvents(false);
+		RegisterGridTrigger();
+	}
+
+	// Remember where the pickup was placed so a soft reset can put it back
+	InitialOwnerTransform = GetOwner()->GetActorTransform();
+
+	if (UStrikesLevelResetSubsystem* ResetSubsystem = GetWorld()->GetSubsystem<UStrikesLevelResetSubsystem>())
+	{
+		ResetSubsystem->Register(this);
+	}
+}
+
+void UTP_PickUpComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UStrikesTriggerGridSubsystem* TriggerGrid = GetWorld()->GetSubsystem<UStrikesTriggerGridSubsystem>())
+	{
+		TriggerGrid->Unregister(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UTP_PickUpComponent::RegisterGridTrigger()
+{
+	if (UStrikesTriggerGridSubsystem* TriggerGrid = GetWorld()->GetSubsystem<UStrikesTriggerGridSubsystem>())
+	{
+		TriggerGrid->RegisterSphere(this, GetComponentLocation(), GetScaledSphereRadius());
+	}
+}
+
+void UTP_PickUpComponent::RestoreInitialState()
+{
+	// Take the weapon back from the character that picked it up
+	if (UTP_WeaponComponent* Weapon = GetOwner()->FindComponentByClass<UTP_WeaponComponent>())
+	{
+		Weapon->DetachWeapon();
+	}
+
+	GetOwner()->SetActorTransform(InitialOwnerTransform, false, nullptr, ETeleportType::ResetPhysics);
+
+	// Listen for overlaps again so the weapon can be picked up
+	OnComponentBeginOverlap.AddUniqueDynamic(this, &UTP_PickUpComponent::OnSphereBeginOverlap);
+
+	if (bUseTriggerGrid)
+	{
+		// Registering again moves the sphere back and re-enables it
+		if (UStrikesTriggerGridSubsystem* TriggerGrid = GetWorld()->GetSubsystem<UStrikesTriggerGridSubsystem>())
+		{
+			TriggerGrid->Unregister(this);
+		}
+		RegisterGridTrigger();
+	}
+}
+
+void UTP_PickUpComponent::OnGridTriggerBegin(AStrikesCharacter* Character)
+{
+	OnSphereBeginOverlap(this, Character, nullptr, INDEX_NONE, false, FHitResult());
 }
 
 void UTP_PickUpComponent::OnSphereBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
+	// Only the server hands out weapons
+	if (!GetOwner()->HasAuthority())
+	{
+		return;
+	}
+
 	// Checking if it is a First Person Character overlapping
 	AStrikesCharacter* Character = Cast<AStrikesCharacter>(OtherActor);
 	if(Character != nullptr)
 	{
 		// Notify that the actor is being picked up
 		OnPickUp.Broadcast(Character);
+		INC_DWORD_STAT(STAT_StrikesPickups);
 
 		// Unregister from the Overlap Event so it is no longer triggered
 		OnComponentBeginOverlap.RemoveAll(this);
+
+		if (UStrikesTriggerGridSubsystem* TriggerGrid = GetWorld()->GetSubsystem<UStrikesTriggerGridSubsystem>())
+		{
+			TriggerGrid->SetTriggerEnabled(this, false);
+		}
 	}
 }
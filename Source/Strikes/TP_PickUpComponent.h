@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "Components/SphereComponent.h"
 #include "StrikesCharacter.h"
+#include "StrikesResettable.h"
+#include "StrikesTriggerGrid.h"
 #include "TP_PickUpComponent.generated.h"
 
 // Declaration of the delegate that will be called when someone picks this up
@@ -12,7 +14,7 @@
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPickUp, AStrikesCharacter*, PickUpCharacter);
 
 UCLASS(Blueprintable, BlueprintType, ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
-class STRIKES_API UTP_PickUpComponent : public USphereComponent
+class STRIKES_API UTP_PickUpComponent : public USphereComponent, public IStrikesResettable, public IStrikesGridTrigger
 {
 	GENERATED_BODY()
 
@@ -22,13 +24,34 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Interaction")
 	FOnPickUp OnPickUp;
 
+	/** Detect characters through the trigger grid instead of physics overlap events */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Interaction")
+	bool bUseTriggerGrid = false;
+
 	UTP_PickUpComponent();
+
+	/** Takes the weapon back from whoever picked it up and makes it available again */
+	virtual void RestoreInitialState() override;
+
+	/** Picks the weapon up for a character that walked into the sphere */
+	virtual void OnGridTriggerBegin(AStrikesCharacter* Character) override;
+
 protected:
 
 	/** Called when the game starts */
 	virtual void BeginPlay() override;
 
+	/** Removes the sphere from the trigger grid */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/** Code for when something overlaps this component */
 	UFUNCTION()
 	void OnSphereBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+private:
+	/** Adds the sphere to the trigger grid at its current location */
+	void RegisterGridTrigger();
+
+	/** Transform of the owning actor when the game started */
+	FTransform InitialOwnerTransform;
 };
\ No newline at end of file
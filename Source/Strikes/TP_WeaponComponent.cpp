@@ -4,93 +4,513 @@
 #include "TP_WeaponComponent.h"
 #include "StrikesCharacter.h"
 #include "StrikesProjectile.h"
+#include "StrikesHitscan.h"
+#include "StrikesLagCompensation.h"
+#include "StrikesProjectileBatch.h"
+#include "StrikesProjectilePool.h"
+#include "StrikesStats.h"
 #include "GameFramework/PlayerController.h"
 #include "Camera/PlayerCameraManager.h"
+#include "Components/SphereComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "Animation/AnimInstance.h"
 #include "Engine/LocalPlayer.h"
 #include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "GameFramework/ProjectileMovementComponent.h"
 
 // Sets default values for this component's properties
 UTP_WeaponComponent::UTP_WeaponComponent()
 {
 	// Default offset from the character location for projectiles to spawn
 	MuzzleOffset = FVector(100.0f, 0.0f, 10.0f);
+
+	// Ticks to schedule shots, but only while the trigger is held or shots are queued
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+
+	// Replicates its holder and attachment; shots themselves are fired on the server
+	SetIsReplicatedByDefault(true);
+}
+
+void UTP_WeaponComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// A component can only replicate through a replicated actor
+	AActor* Owner = GetOwner();
+	if (Owner->HasAuthority() && !Owner->GetIsReplicated())
+	{
+		Owner->SetReplicates(true);
+	}
+}
+
+void UTP_WeaponComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(UTP_WeaponComponent, Character, Params);
 }
 
 
 void UTP_WeaponComponent::Fire()
 {
-	if (Character == nullptr || Character->GetController() == nullptr)
+	// Shots are fired by the server
+	if (Character == nullptr || Character->GetController() == nullptr || !Character->HasAuthority())
 	{
 		return;
 	}
 
-	// Attempt to fire a projectile if:
-	// - ProjectileClass is valid 
-	// - The character's magic is above a small threshold (not nearly zero)
-	// - The character is allowed to use magic
-	if (ProjectileClass != nullptr && !FMath::IsNearlyZero(Character->Magic, 0.001f) &&
-		Character->bCanUseMagic)
+	FVector SpawnLocation;
+	FRotator SpawnRotation;
+	GetMuzzleTransform(SpawnLocation, SpawnRotation);
+
+	FireShot(SpawnLocation, SpawnRotation, 0.f);
+}
+
+void UTP_WeaponComponent::GetMuzzleTransform(FVector& OutLocation, FRotator& OutRotation) const
+{
+	// Local players aim with the camera, anything else (including remote players on the server) with its control rotation
+	const APlayerController* PlayerController = Cast<APlayerController>(Character->GetController());
+	OutRotation = PlayerController != nullptr && PlayerController->IsLocalController() &&
+	              PlayerController->PlayerCameraManager != nullptr
+		              ? PlayerController->PlayerCameraManager->GetCameraRotation()
+		              : Character->GetControlRotation();
+
+	// MuzzleOffset is in camera space, so transform it to world space before offsetting from the character location to find the final muzzle position
+	OutLocation = GetOwner()->GetActorLocation() + OutRotation.RotateVector(MuzzleOffset);
+}
+
+bool UTP_WeaponComponent::FireShot(const FVector& SpawnLocation, const FRotator& SpawnRotation, const float Lag)
+{
+	STRIKES_SCOPE_CYCLE_COUNTER(STAT_StrikesWeaponFire);
+
+	if (!CanFireShot())
 	{
-		UWorld* const World = GetWorld();
-		if (World != nullptr)
+		return false;
+	}
+
+	UWorld* const World = GetWorld();
+	if (World != nullptr)
+	{
+		UStrikesHitscanSubsystem* Hitscan = World->GetSubsystem<UStrikesHitscanSubsystem>();
+		UStrikesProjectileBatchSubsystem* ProjectileBatch = World->GetSubsystem<UStrikesProjectileBatchSubsystem>();
+		UStrikesProjectilePoolSubsystem* ProjectilePool = World->GetSubsystem<UStrikesProjectilePoolSubsystem>();
+
+		// Remote shooters aimed at the other characters where they were RewindOffset seconds ago
+		UStrikesLagCompensationSubsystem* LagCompensation = World->GetSubsystem<UStrikesLagCompensationSubsystem>();
+		const bool bRewind = RewindOffset > 0.f && LagCompensation != nullptr && LagCompensation->IsEnabled();
+		const double RewindTime = bRewind
+			                          ? LagCompensation->ClampRewindTime(World->GetTimeSeconds() - Lag - RewindOffset)
+			                          : -1.0;
+
+		// A rewound shot continues from where its path up to now ended, which already includes Lag
+		FVector LaunchLocation = SpawnLocation;
+		float LaunchLag = Lag;
+		if (bRewind && ProjectileMode != EProjectileMode::EHitscan)
 		{
-			APlayerController* PlayerController = Cast<APlayerController>(Character->GetController());
-			const FRotator SpawnRotation = PlayerController->PlayerCameraManager->GetCameraRotation();
-			// MuzzleOffset is in camera space, so transform it to world space before offsetting from the character location to find the final muzzle position
-			const FVector SpawnLocation = GetOwner()->GetActorLocation() + SpawnRotation.RotateVector(MuzzleOffset);
+			LaunchLocation = ResolveRewoundProjectile(LagCompensation, SpawnLocation, SpawnRotation, RewindTime);
+			LaunchLag = 0.f;
+		}
 
+		// A shot that was due earlier in the frame has already been flying for LaunchLag seconds
+		FVector LaggedLocation = LaunchLocation;
+		if (LaunchLag > 0.f)
+		{
+			if (const UProjectileMovementComponent* Movement =
+				ProjectileClass->GetDefaultObject<AStrikesProjectile>()->GetProjectileMovement())
+			{
+				LaggedLocation += SpawnRotation.Vector() * Movement->InitialSpeed * LaunchLag;
+			}
+		}
+
+		if (ProjectileMode == EProjectileMode::EHitscan && Hitscan != nullptr)
+		{
+			// Trace the shot from the muzzle together with every other hitscan shot this frame
+			Hitscan->QueueShot(ProjectileClass, SpawnLocation, SpawnRotation.Vector(), Character, RewindTime);
+		}
+		else if (ProjectileMode != EProjectileMode::EActor && ProjectileMode != EProjectileMode::EHitscan &&
+			ProjectileBatch != nullptr)
+		{
+			// Simulate the shot in bulk with every other batched projectile, starting LaunchLag seconds into its flight
+			const bool bAsyncCollision = ProjectileMode == EProjectileMode::EBatchedAsync;
+			ProjectileBatch->Spawn(ProjectileClass, LaunchLocation, SpawnRotation, bAsyncCollision, LaunchLag);
+
+			// Clients simulate the same shot from its launch parameters
+			if (GetNetMode() != NM_Standalone)
+			{
+				FStrikesNetProjectileSpawn Spawn;
+				Spawn.Origin = LaunchLocation;
+				Spawn.Direction = SpawnRotation.Vector();
+				Spawn.SpawnTime = static_cast<float>(Character->GetServerTime() - LaunchLag);
+				Spawn.bAsyncCollision = bAsyncCollision;
+				MulticastProjectileSpawned(Spawn);
+			}
+		}
+		else if (ProjectilePool != nullptr && ProjectilePool->bEnabled)
+		{
+			// Take a recycled projectile from the pool and launch it from the muzzle
+			ProjectilePool->Acquire(ProjectileClass, LaggedLocation, SpawnRotation);
+		}
+		else
+		{
 			//Set Spawn Collision Handling Override
 			FActorSpawnParameters ActorSpawnParams;
 			ActorSpawnParams.SpawnCollisionHandlingOverride =
 				ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding;
 
 			// Spawn the projectile at the muzzle
-			World->SpawnActor<AStrikesProjectile>(ProjectileClass, SpawnLocation, SpawnRotation, ActorSpawnParams);
+			World->SpawnActor<AStrikesProjectile>(ProjectileClass, LaggedLocation, SpawnRotation, ActorSpawnParams);
 		}
+	}
+
+	// Sound and animation play wherever the shot is seen, except where they were predicted
+	MulticastFireEffects(PredictionKey);
+
+	// Initialize all magic-related timers and reset their states.
+	Character->InitializeMagicTimers();
+
+	// The owning client learns that its predicted shot went out, with the magic it spent
+	ResolvePrediction(true);
+
+	++ShotsFired;
+	INC_DWORD_STAT(STAT_StrikesShots);
+	return true;
+}
+
+FVector UTP_WeaponComponent::ResolveRewoundProjectile(UStrikesLagCompensationSubsystem* LagCompensation,
+                                                      const FVector& SpawnLocation, const FRotator& SpawnRotation,
+                                                      const double RewindTime)
+{
+	const AStrikesProjectile* Defaults = ProjectileClass->GetDefaultObject<AStrikesProjectile>();
+	const UProjectileMovementComponent* Movement = Defaults->GetProjectileMovement();
+	if (Movement == nullptr)
+	{
+		return SpawnLocation;
+	}
+
+	// Where the projectile would be by now if it had been launched when the shooter fired
+	const FVector Direction = SpawnRotation.Vector();
+	const double FlightTime = GetWorld()->GetTimeSeconds() - RewindTime;
+	const FVector End = SpawnLocation + Direction * Movement->InitialSpeed * FlightTime;
+
+	ECollisionChannel Channel;
+	FCollisionResponseParams ResponseParams;
+	AStrikesProjectile::GetCollisionChannelAndResponse(Channel, ResponseParams);
+
+	FHitResult WorldHit;
+	FVector HitLocation;
+	AStrikesCharacter* Target = LagCompensation->ResolveShot(SpawnLocation, End, RewindTime, Character, Channel,
+	                                                         ResponseParams, WorldHit, HitLocation);
+	if (Target != nullptr)
+	{
+		// The projectile is still launched from the hit, so everyone sees the shot land
+		LagCompensation->ApplyRewoundHit(Target, Character, HitLocation, Direction);
+		return HitLocation;
+	}
+
+	if (WorldHit.bBlockingHit)
+	{
+		// Stop short of the wall by the projectile's radius, so it bounces off it instead of starting inside it
+		const float Radius = Defaults->GetCollisionComp() != nullptr
+			                     ? Defaults->GetCollisionComp()->GetScaledSphereRadius()
+			                     : 0.f;
+		return WorldHit.Location - Direction * FMath::Min(Radius, static_cast<float>(WorldHit.Distance));
+	}
+
+	return End;
+}
 
-		// Try and play the sound if specified
-		if (FireSound != nullptr)
+void UTP_WeaponComponent::SetShooterViewTime(const double ShooterViewTime)
+{
+	const UStrikesLagCompensationSubsystem* LagCompensation =
+		GetWorld()->GetSubsystem<UStrikesLagCompensationSubsystem>();
+	if (LagCompensation == nullptr)
+	{
+		RewindOffset = 0.f;
+		return;
+	}
+
+	// Kept for the whole press, so auto fire rewinds every shot by the same amount
+	const double Now = GetWorld()->GetTimeSeconds();
+	RewindOffset = static_cast<float>(Now - LagCompensation->ClampRewindTime(ShooterViewTime));
+}
+
+bool UTP_WeaponComponent::CanFireShot() const
+{
+	// Attempt to fire a projectile if:
+	// - ProjectileClass is valid 
+	// - The character has magic left and is allowed to use it
+	return ProjectileClass != nullptr && Character->CanFireMagic();
+}
+
+uint16 UTP_WeaponComponent::PredictShot()
+{
+	if (!CanFireShot())
+	{
+		return 0;
+	}
+
+	// Show the shot right away; the server fires it and the projectile replicates
+	PlayFireEffects();
+
+	// Spends magic and shows overheat until the server answers
+	return Character->PredictMagicSpend();
+}
+
+void UTP_WeaponComponent::SetPredictionKey(const uint16 InPredictionKey)
+{
+	// A newer press took the place of a predicted shot that hasn't been fired
+	ResolvePrediction(false);
+	PredictionKey = InPredictionKey;
+}
+
+void UTP_WeaponComponent::ResolvePrediction(const bool bFired)
+{
+	if (PredictionKey != 0 && Character != nullptr)
+	{
+		Character->AcknowledgePrediction(PredictionKey, bFired);
+	}
+	PredictionKey = 0;
+}
+
+void UTP_WeaponComponent::OnPredictionRejected()
+{
+	if (Character == nullptr || FireAnimation == nullptr)
+	{
+		return;
+	}
+
+	if (UAnimInstance* AnimInstance = Character->GetMesh1P()->GetAnimInstance())
+	{
+		AnimInstance->Montage_Stop(0.1f, FireAnimation);
+	}
+}
+
+void UTP_WeaponComponent::MulticastFireEffects_Implementation(const uint16 EffectsPredictionKey)
+{
+	// Nobody sees or hears the shot on a dedicated server
+	if (Character == nullptr || GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+
+	// The owning client played it when it predicted the shot
+	if (EffectsPredictionKey != 0 && Character->IsLocallyControlled() && !Character->HasAuthority())
+	{
+		return;
+	}
+
+	PlayFireEffects();
+}
+
+void UTP_WeaponComponent::PlayFireEffects()
+{
+	// Try and play the sound if specified
+	if (FireSound != nullptr)
+	{
+		UGameplayStatics::PlaySoundAtLocation(this, FireSound, Character->GetActorLocation());
+	}
+
+	// Try and play a firing animation if specified
+	if (FireAnimation != nullptr)
+	{
+		// Get the animation object for the arms mesh
+		UAnimInstance* AnimInstance = Character->GetMesh1P()->GetAnimInstance();
+		if (AnimInstance != nullptr)
 		{
-			UGameplayStatics::PlaySoundAtLocation(this, FireSound, Character->GetActorLocation());
+			AnimInstance->Montage_Play(FireAnimation, 1.f);
 		}
+	}
+}
+
+void UTP_WeaponComponent::MulticastProjectileSpawned_Implementation(const FStrikesNetProjectileSpawn& Spawn)
+{
+	// The server already launched it; dedicated servers have nothing to show
+	if (GetOwnerRole() == ROLE_Authority || ProjectileClass == nullptr)
+	{
+		return;
+	}
+
+	UWorld* const World = GetWorld();
+	UStrikesProjectileBatchSubsystem* ProjectileBatch = World->GetSubsystem<UStrikesProjectileBatchSubsystem>();
+	const AGameStateBase* GameState = World->GetGameState();
+	if (ProjectileBatch == nullptr || GameState == nullptr)
+	{
+		return;
+	}
+
+	// Catch up with the time the shot spent in flight before it arrived
+	const float Age = FMath::Max(static_cast<float>(GameState->GetServerWorldTimeSeconds() - Spawn.SpawnTime), 0.f);
+	ProjectileBatch->Spawn(ProjectileClass, Spawn.Origin, Spawn.Direction.Rotation(), Spawn.bAsyncCollision, Age);
+}
+
+void UTP_WeaponComponent::StartFire()
+{
+	if (Character == nullptr)
+	{
+		return;
+	}
+
+	// The server schedules and fires the shots
+	if (!Character->HasAuthority())
+	{
+		// Predict the first shot of the press; the server acknowledges its key with the magic it replicates
+		Character->ServerStartFire(Character->GetViewTime(), PredictShot());
+		return;
+	}
+
+	if (Character->GetController() == nullptr)
+	{
+		ResolvePrediction(false);
+		return;
+	}
+
+	bTriggerHeld = true;
+	SetComponentTickEnabled(true);
+
+	// Queue the shots for this press; auto fire keeps going while the trigger is held instead
+	switch (FireMode)
+	{
+	case EFireMode::ESemiAuto:
+		PendingShots = FMath::Max(PendingShots, 1);
+		break;
+	case EFireMode::EBurst:
+		PendingShots = FMath::Max(PendingShots, BurstCount);
+		break;
+	case EFireMode::EAuto:
+		break;
+	}
+
+	// Time spent idle doesn't add up to extra shots
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (NextShotTime < Now)
+	{
+		NextShotTime = Now;
+		GetMuzzleTransform(PreviousMuzzleLocation, PreviousMuzzleRotation);
+	}
+
+	// Fire right away if a shot is due, rather than waiting for the next tick
+	UpdateFiring(0.f);
+}
+
+void UTP_WeaponComponent::StopFire()
+{
+	if (Character != nullptr && !Character->HasAuthority())
+	{
+		Character->ServerStopFire();
+		return;
+	}
+
+	// Queued semi-auto and burst shots still go out
+	bTriggerHeld = false;
+
+	if (PendingShots == 0)
+	{
+		SetComponentTickEnabled(false);
+		RewindOffset = 0.f;
+	}
+}
+
+void UTP_WeaponComponent::TickComponent(float DeltaTime, ELevelTick TickType,
+                                        FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-		// Try and play a firing animation if specified
-		if (FireAnimation != nullptr)
+	UpdateFiring(DeltaTime);
+}
+
+void UTP_WeaponComponent::UpdateFiring(const float DeltaTime)
+{
+	if (Character == nullptr || Character->GetController() == nullptr || !Character->HasAuthority())
+	{
+		return;
+	}
+
+	FVector MuzzleLocation;
+	FRotator MuzzleRotation;
+	GetMuzzleTransform(MuzzleLocation, MuzzleRotation);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const double FrameStart = Now - DeltaTime;
+	const double ShotInterval = 60.0 / FMath::Max(RoundsPerMinute, 1.f);
+
+	int32 FrameShots = 0;
+	while (FrameShots < MaxShotsPerFrame && NextShotTime <= Now &&
+		(PendingShots > 0 || (FireMode == EFireMode::EAuto && bTriggerHeld)))
+	{
+		// Place the shot where the muzzle was when it was due, between the previous tick and this one
+		const float Alpha = DeltaTime > 0.f
+			                    ? FMath::Clamp(static_cast<float>((NextShotTime - FrameStart) / DeltaTime), 0.f, 1.f)
+			                    : 1.f;
+		const FVector ShotLocation = FMath::Lerp(PreviousMuzzleLocation, MuzzleLocation, Alpha);
+		const FRotator ShotRotation =
+			FQuat::Slerp(PreviousMuzzleRotation.Quaternion(), MuzzleRotation.Quaternion(), Alpha).Rotator();
+
+		if (!FireShot(ShotLocation, ShotRotation, static_cast<float>(Now - NextShotTime)))
 		{
-			// Get the animation object for the arms mesh
-			UAnimInstance* AnimInstance = Character->GetMesh1P()->GetAnimInstance();
-			if (AnimInstance != nullptr)
+			// Out of magic: the shot goes out as soon as it can, unless the trigger was already released
+			NextShotTime = Now;
+			if (!bTriggerHeld)
 			{
-				AnimInstance->Montage_Play(FireAnimation, 1.f);
+				PendingShots = 0;
+				ResolvePrediction(false);
 			}
+			break;
 		}
 
-		// Initialize all magic-related timers and reset their states.
-		Character->InitializeMagicTimers();
+		// Keep the remainder so the rate doesn't depend on the frame rate
+		NextShotTime += ShotInterval;
+		PendingShots = FMath::Max(PendingShots - 1, 0);
+		++FrameShots;
+	}
+
+	if (FrameShots == MaxShotsPerFrame && NextShotTime < Now)
+	{
+		// Drop the backlog of a long hitch
+		NextShotTime = Now;
+	}
+
+	PreviousMuzzleLocation = MuzzleLocation;
+	PreviousMuzzleRotation = MuzzleRotation;
+
+	// Nothing left to schedule until the next press, which sets its own rewind
+	if (!bTriggerHeld && PendingShots == 0)
+	{
+		SetComponentTickEnabled(false);
+		RewindOffset = 0.f;
 	}
 }
 
 bool UTP_WeaponComponent::AttachWeapon(AStrikesCharacter* TargetCharacter)
 {
-	Character = TargetCharacter;
-
-	if (Character)
+	// Check that the character is valid, and has no weapon component yet
+	if (TargetCharacter == nullptr || TargetCharacter->GetInstanceComponents().FindItemByClass<UTP_WeaponComponent>())
 	{
-		// Subscribe to the overheat event
-		Character->OnOverheat.AddDynamic(this, &UTP_WeaponComponent::OnOverheatEvent);
+		return false;
 	}
 
-
-	// Check that the character is valid, and has no weapon component yet
-	if (Character == nullptr || Character->GetInstanceComponents().FindItemByClass<UTP_WeaponComponent>())
+	// The server decides who holds the weapon; clients follow through OnRep_Character
+	if (!TargetCharacter->HasAuthority())
 	{
 		return false;
 	}
 
+	Character = TargetCharacter;
+	MARK_PROPERTY_DIRTY_FROM_NAME(UTP_WeaponComponent, Character, this);
+
+	// Remember where the weapon sat before being picked up so DetachWeapon can put it back
+	PickUpAttachParent = GetAttachParent();
+	PickUpRelativeTransform = GetRelativeTransform();
+
 	// Attach the weapon to the First Person Character
 	FAttachmentTransformRules AttachmentRules(EAttachmentRule::SnapToTarget, true);
 	AttachToComponent(Character->GetMesh1P(), AttachmentRules, FName(TEXT("GripPoint")));
@@ -98,6 +518,63 @@ bool UTP_WeaponComponent::AttachWeapon(AStrikesCharacter* TargetCharacter)
 	// add the weapon as an instance component to the character
 	Character->AddInstanceComponent(this);
 
+	// Create the pooled projectiles now rather than on the first shot
+	if (ProjectileMode == EProjectileMode::EActor)
+	{
+		if (UStrikesProjectilePoolSubsystem* ProjectilePool = GetWorld()->GetSubsystem<UStrikesProjectilePoolSubsystem>())
+		{
+			ProjectilePool->Prewarm(ProjectileClass);
+		}
+	}
+
+	OnEquipped();
+
+	return true;
+}
+
+void UTP_WeaponComponent::OnEquipped()
+{
+	// Subscribe to the overheat event
+	Character->OnOverheat.AddUniqueDynamic(this, &UTP_WeaponComponent::OnOverheatEvent);
+	Character->OnMagicPredictionRejected.AddUniqueDynamic(this, &UTP_WeaponComponent::OnPredictionRejected);
+
+	// Set up the overheat material once, rather than looking the gun mesh up on every overheat change
+	InitializeOverheatMaterial();
+
+	AddInputBindings();
+}
+
+void UTP_WeaponComponent::OnUnequipped(AStrikesCharacter* OldCharacter)
+{
+	// Stop listening to the character and restore the default material.
+	ShowOverheat(false);
+	OldCharacter->OnOverheat.RemoveDynamic(this, &UTP_WeaponComponent::OnOverheatEvent);
+	OldCharacter->OnMagicPredictionRejected.RemoveDynamic(this, &UTP_WeaponComponent::OnPredictionRejected);
+
+	RemoveInputBindings(OldCharacter);
+}
+
+void UTP_WeaponComponent::OnRep_Character(AStrikesCharacter* OldCharacter)
+{
+	if (OldCharacter != nullptr)
+	{
+		OnUnequipped(OldCharacter);
+	}
+
+	if (Character != nullptr)
+	{
+		OnEquipped();
+	}
+}
+
+void UTP_WeaponComponent::AddInputBindings()
+{
+	// Only the machine controlling the character reads its input
+	if (!Character->IsLocallyControlled())
+	{
+		return;
+	}
+
 	// Set up action bindings
 	if (APlayerController* PlayerController = Cast<APlayerController>(Character->GetController()))
 	{
@@ -111,12 +588,15 @@ bool UTP_WeaponComponent::AttachWeapon(AStrikesCharacter* TargetCharacter)
 		if (UEnhancedInputComponent* EnhancedInputComponent = Cast<UEnhancedInputComponent>(
 			PlayerController->InputComponent))
 		{
-			// Fire
-			EnhancedInputComponent->BindAction(FireAction, ETriggerEvent::Triggered, this, &UTP_WeaponComponent::Fire);
+			// Fire; the weapon schedules the shots itself while the trigger is held
+			FireBindingHandles.Add(EnhancedInputComponent->BindAction(
+				FireAction, ETriggerEvent::Started, this, &UTP_WeaponComponent::StartFire).GetHandle());
+			FireBindingHandles.Add(EnhancedInputComponent->BindAction(
+				FireAction, ETriggerEvent::Completed, this, &UTP_WeaponComponent::StopFire).GetHandle());
+			FireBindingHandles.Add(EnhancedInputComponent->BindAction(
+				FireAction, ETriggerEvent::Canceled, this, &UTP_WeaponComponent::StopFire).GetHandle());
 		}
 	}
-
-	return true;
 }
 
 void UTP_WeaponComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -127,8 +607,42 @@ void UTP_WeaponComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 		return;
 	}
 
+	RemoveInputBindings(Character);
+}
+
+void UTP_WeaponComponent::DetachWeapon()
+{
+	// Check if the character is valid before proceeding.
+	if (Character == nullptr || !Character->HasAuthority())
+	{
+		return;
+	}
+
+	OnUnequipped(Character);
+
+	// Drop anything still queued.
+	bTriggerHeld = false;
+	PendingShots = 0;
+	ResolvePrediction(false);
+	SetComponentTickEnabled(false);
+	RewindOffset = 0.f;
+
+	// Hand the weapon back to the actor it was picked up from.
+	Character->RemoveInstanceComponent(this);
+	if (PickUpAttachParent != nullptr)
+	{
+		AttachToComponent(PickUpAttachParent, FAttachmentTransformRules::KeepRelativeTransform);
+		SetRelativeTransform(PickUpRelativeTransform);
+	}
+
+	Character = nullptr;
+	MARK_PROPERTY_DIRTY_FROM_NAME(UTP_WeaponComponent, Character, this);
+}
+
+void UTP_WeaponComponent::RemoveInputBindings(AStrikesCharacter* FromCharacter)
+{
 	// Attempt to retrieve the PlayerController from the character.
-	if (APlayerController* PlayerController = Cast<APlayerController>(Character->GetController()))
+	if (APlayerController* PlayerController = Cast<APlayerController>(FromCharacter->GetController()))
 	{
 		// Attempt to retrieve the EnhancedInputLocalPlayerSubsystem from the PlayerController's local player.
 		if (UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<
@@ -137,10 +651,40 @@ void UTP_WeaponComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 			// Remove the input mapping context to clean up input bindings.
 			Subsystem->RemoveMappingContext(FireMappingContext);
 		}
+
+		// Remove the Fire bindings so the weapon no longer reacts to input.
+		if (UEnhancedInputComponent* EnhancedInputComponent = Cast<UEnhancedInputComponent>(
+			PlayerController->InputComponent))
+		{
+			for (const uint32 FireBindingHandle : FireBindingHandles)
+			{
+				EnhancedInputComponent->RemoveBindingByHandle(FireBindingHandle);
+			}
+		}
 	}
+
+	FireBindingHandles.Reset();
 }
 
 
+void UTP_WeaponComponent::InitializeOverheatMaterial()
+{
+	// The weapon is the gun mesh attached to the character's arms.
+	// Base the dynamic instance on the default gun material so both states share one material.
+	GunMaterial = CreateDynamicMaterialInstance(0, Character->GunDefaultMaterial);
+
+	bHasOverheatParameter = GunMaterial != nullptr &&
+		GunMaterial->GetVectorParameterValue(FMaterialParameterInfo(OverheatColorParameterName), DefaultGunColor);
+
+	if (!bHasOverheatParameter)
+	{
+		UE_LOG(LogTemplateCharacter, Warning, TEXT("%s: material has no '%s' parameter, overheat isn't shown"),
+		       *GetNameSafe(this), *OverheatColorParameterName.ToString());
+	}
+
+	bShownOverheat = false;
+}
+
 void UTP_WeaponComponent::SetOverheat(const bool bOverheat)
 {
 	// Check if the character is valid before proceeding.
@@ -149,18 +693,22 @@ void UTP_WeaponComponent::SetOverheat(const bool bOverheat)
 		return;
 	}
 
-	// Retrieve all child components of the character's mesh.
-	TArray<USceneComponent*> ChildComponents;
-	Character->GetMesh1P()->GetChildrenComponents(true, ChildComponents);
+	ShowOverheat(bOverheat);
+}
+
+void UTP_WeaponComponent::ShowOverheat(const bool bOverheat)
+{
+	// Overheat is raised on every shot, so only touch the material when the state actually changes.
+	if (bOverheat == bShownOverheat)
+	{
+		return;
+	}
+	bShownOverheat = bOverheat;
 
-	// Check if the first child component is a skeletal mesh component.
-	if (USkeletalMeshComponent* GunComponent = Cast<USkeletalMeshComponent>(ChildComponents[0]))
+	if (bHasOverheatParameter)
 	{
-		// Set the material of the mesh based on whether the weapon is overheating.
-		GunComponent->SetMaterial(
-			0,
-			bOverheat ? Character->GunOverheatMaterial : Character->GunDefaultMaterial
-		);
+		// Tint the same material instance; the material itself is never swapped.
+		GunMaterial->SetVectorParameterValue(OverheatColorParameterName, bOverheat ? OverheatColor : DefaultGunColor);
 	}
 }
 
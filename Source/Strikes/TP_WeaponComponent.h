@@ -4,9 +4,42 @@
 
 #include "CoreMinimal.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "StrikesNetTypes.h"
 #include "TP_WeaponComponent.generated.h"
 
 class AStrikesCharacter;
+class UMaterialInstanceDynamic;
+
+/** How the weapon simulates the projectiles it fires */
+UENUM(BlueprintType)
+enum class EProjectileMode : uint8
+{
+	/** Every shot is an AStrikesProjectile actor (recycled through the projectile pool when enabled). */
+	EActor,
+
+	/** Shots are simulated in bulk by the projectile batch subsystem without an actor per shot; sweeps run serially. */
+	EBatched,
+
+	/** Like EBatched, but collision sweeps are issued asynchronously and resolved on the next frame. */
+	EBatchedAsync,
+
+	/** Shots hit instantly, queued and line traced in one serial loop per frame by the hitscan subsystem. */
+	EHitscan
+};
+
+/** How holding the fire input turns into shots */
+UENUM(BlueprintType)
+enum class EFireMode : uint8
+{
+	/** One shot per press. */
+	ESemiAuto,
+
+	/** BurstCount shots per press, completed even if the input is released. */
+	EBurst,
+
+	/** Shots keep coming at RoundsPerMinute while the input is held. */
+	EAuto
+};
 
 UCLASS(Blueprintable, BlueprintType, ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class STRIKES_API UTP_WeaponComponent : public USkeletalMeshComponent
@@ -18,6 +51,26 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category=Projectile)
 	TSubclassOf<class AStrikesProjectile> ProjectileClass;
 
+	/** Whether shots are spawned as projectile actors or simulated in bulk */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Projectile)
+	EProjectileMode ProjectileMode = EProjectileMode::EActor;
+
+	/** How holding the fire input turns into shots */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Gameplay)
+	EFireMode FireMode = EFireMode::EAuto;
+
+	/** Maximum fire rate; shots are scheduled on world time, so it doesn't depend on the frame rate */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Gameplay, meta=(ClampMin="1"))
+	float RoundsPerMinute = 600.f;
+
+	/** Shots per press in EBurst mode */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Gameplay, meta=(ClampMin="1"))
+	int32 BurstCount = 3;
+
+	/** Limit on shots fired in one frame, so a long hitch doesn't release a flood of them */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Gameplay, meta=(ClampMin="1"))
+	int32 MaxShotsPerFrame = 8;
+
 	/** Sound to play each time we fire */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Gameplay)
 	USoundBase* FireSound;
@@ -30,6 +83,14 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Gameplay)
 	FVector MuzzleOffset;
 
+	/** Vector parameter of the gun material that is tinted while the weapon is overheated */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Gameplay)
+	FName OverheatColorParameterName = TEXT("BodyColor");
+
+	/** Color OverheatColorParameterName is set to while the weapon is overheated */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Gameplay)
+	FLinearColor OverheatColor = FLinearColor(1.f, 0.05f, 0.02f);
+
 	/** MappingContext */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Input, meta=(AllowPrivateAccess = "true"))
 	class UInputMappingContext* FireMappingContext;
@@ -45,19 +106,63 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Weapon")
 	bool AttachWeapon(AStrikesCharacter* TargetCharacter);
 
+	/** Detaches the weapon from its character and puts it back where it was before AttachWeapon */
+	UFUNCTION(BlueprintCallable, Category="Weapon")
+	void DetachWeapon();
+
 	/** Make the weapon Fire a Projectile */
 	UFUNCTION(BlueprintCallable, Category="Weapon")
 	void Fire();
 
+	/** Pulls the trigger: starts scheduling shots according to FireMode and RoundsPerMinute */
+	UFUNCTION(BlueprintCallable, Category="Weapon")
+	void StartFire();
+
+	/** Releases the trigger; a burst in progress still completes */
+	UFUNCTION(BlueprintCallable, Category="Weapon")
+	void StopFire();
+
+	/**
+	 * Sets how far in the past the shooter sees the other characters, for lag compensation of the next shots.
+	 *
+	 * @param ShooterViewTime Server time of the world state the shooter saw when pulling the trigger.
+	 */
+	void SetShooterViewTime(double ShooterViewTime);
+
+	/**
+	 * Sets the key of the magic spend the owning client predicted for the next shot.
+	 * The shot's effects are not played again on that client, and the key is acknowledged once the shot is fired.
+	 * A key still waiting for its shot is acknowledged as dropped.
+	 */
+	void SetPredictionKey(uint16 InPredictionKey);
+
+	/** Returns the number of shots fired since the weapon was created */
+	UFUNCTION(BlueprintPure, Category="Weapon")
+	int32 GetShotsFired() const { return ShotsFired; }
+
 	/** Function to handle the overheat event */
 	UFUNCTION()
 	void OnOverheatEvent(bool bOverheat);
 
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType,
+	                           FActorComponentTickFunction* ThisTickFunction) override;
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 protected:
+	/** Makes sure the actor carrying the weapon replicates, so the weapon can */
+	virtual void BeginPlay() override;
+
 	/** Ends gameplay for this component. */
 	UFUNCTION()
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
+	/**
+	 * Creates the dynamic material instance used to show overheat on the weapon mesh, and remembers the color
+	 * OverheatColorParameterName goes back to.
+	 */
+	void InitializeOverheatMaterial();
+
 	/**
 	 * Updates the weapon's material based on its overheat state.
 	 *
@@ -65,7 +170,149 @@ protected:
 	 */
 	void SetOverheat(bool bOverheat);
 
+	/**
+	 * Shows the overheat state on the weapon's material.
+	 *
+	 * @param bOverheat Whether the weapon is overheating.
+	 */
+	void ShowOverheat(bool bOverheat);
+
+	/** Adds the fire mapping context and bindings to the character's player controller, if it is local */
+	void AddInputBindings();
+
+	/**
+	 * Removes the fire mapping context and binding from a character's player controller.
+	 *
+	 * @param FromCharacter Character the bindings were added for.
+	 */
+	void RemoveInputBindings(AStrikesCharacter* FromCharacter);
+
+	/** Local setup once the weapon is held by Character: overheat material, events and input */
+	void OnEquipped();
+
+	/**
+	 * Local cleanup once the weapon is no longer held by a character.
+	 *
+	 * @param OldCharacter Character that held the weapon.
+	 */
+	void OnUnequipped(AStrikesCharacter* OldCharacter);
+
+	/** Runs OnEquipped/OnUnequipped on clients when the holder replicates */
+	UFUNCTION()
+	void OnRep_Character(AStrikesCharacter* OldCharacter);
+
+	/**
+	 * Plays the fire sound and animation on every machine that shows them.
+	 *
+	 * @param EffectsPredictionKey Prediction key of the shot; the owning client already played predicted shots.
+	 */
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastFireEffects(uint16 EffectsPredictionKey);
+
+	/** Plays the fire sound and animation locally */
+	void PlayFireEffects();
+
+	/** Whether the character has the magic to fire a shot right now */
+	bool CanFireShot() const;
+
+	/**
+	 * Plays a shot's effects and spends its magic on the owning client ahead of the server.
+	 *
+	 * @return Prediction key to send with the shot, or 0 if no shot could be fired.
+	 */
+	uint16 PredictShot();
+
+	/** Stops the fire animation of a predicted shot the server didn't fire */
+	UFUNCTION()
+	void OnPredictionRejected();
+
+	/**
+	 * Acknowledges PredictionKey to the owning client and clears it.
+	 *
+	 * @param bFired Whether the predicted shot was fired.
+	 */
+	void ResolvePrediction(bool bFired);
+
+	/** Launches the same batched projectile on clients that the server launched, instead of replicating an actor */
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastProjectileSpawned(const FStrikesNetProjectileSpawn& Spawn);
+
+	/** Current muzzle location and rotation, from the player's camera */
+	void GetMuzzleTransform(FVector& OutLocation, FRotator& OutRotation) const;
+
+	/**
+	 * Fires one shot from the given muzzle transform.
+	 *
+	 * @param SpawnLocation Muzzle location at the time of the shot.
+	 * @param SpawnRotation Muzzle rotation at the time of the shot.
+	 * @param Lag How long ago in this frame the shot was due; the projectile starts that far along its path.
+	 * @return True if a shot was fired.
+	 */
+	bool FireShot(const FVector& SpawnLocation, const FRotator& SpawnRotation, float Lag);
+
+	/** Fires every shot that became due during the last frame */
+	void UpdateFiring(float DeltaTime);
+
+	/**
+	 * Tests the path a projectile covered while the shot was on its way to the server against the characters
+	 * as the shooter saw them, and applies the hit if there is one.
+	 *
+	 * @return Where the projectile is by now and is launched from: the character it hit, just short of the world
+	 *         it hit, or the end of its path.
+	 */
+	FVector ResolveRewoundProjectile(class UStrikesLagCompensationSubsystem* LagCompensation, const FVector& SpawnLocation,
+	                              const FRotator& SpawnRotation, double RewindTime);
+
 private:
 	/** The Character holding this weapon*/
-	AStrikesCharacter* Character;
+	UPROPERTY(ReplicatedUsing=OnRep_Character)
+	AStrikesCharacter* Character = nullptr;
+
+	/** Handles of the Fire action bindings created in AttachWeapon */
+	TArray<uint32> FireBindingHandles;
+
+	/** Whether the fire input is held */
+	bool bTriggerHeld = false;
+
+	/** Shots left to fire for the current press */
+	int32 PendingShots = 0;
+
+	/** World time the next shot is due; keeps the sub-frame remainder between frames */
+	double NextShotTime = 0.0;
+
+	/** Muzzle transform on the previous tick, to interpolate shots that fell between frames */
+	FVector PreviousMuzzleLocation = FVector::ZeroVector;
+	FRotator PreviousMuzzleRotation = FRotator::ZeroRotator;
+
+	/** Number of shots fired since the weapon was created */
+	int32 ShotsFired = 0;
+
+	/**
+	 * Seconds the shooter's view of the other characters trails the server.
+	 * Set when a remote player pulls the trigger and cleared once the press is over.
+	 */
+	float RewindOffset = 0.f;
+
+	/** Prediction key of the owning client for the next shot, cleared once it is fired or dropped */
+	uint16 PredictionKey = 0;
+
+	/** Component the weapon was attached to before it was picked up */
+	UPROPERTY()
+	USceneComponent* PickUpAttachParent = nullptr;
+
+	/** Relative transform the weapon had before it was picked up */
+	FTransform PickUpRelativeTransform;
+
+	/** Dynamic material on the gun mesh whose overheat parameter is switched, created in AttachWeapon */
+	UPROPERTY(Transient)
+	UMaterialInstanceDynamic* GunMaterial = nullptr;
+
+	/** Whether GunMaterial has OverheatColorParameterName; otherwise overheat isn't shown on the weapon */
+	bool bHasOverheatParameter = false;
+
+	/** Value of OverheatColorParameterName in the gun material, restored when the overheat ends */
+	FLinearColor DefaultGunColor = FLinearColor::White;
+
+	/** Overheat state currently shown by the material */
+	bool bShownOverheat = false;
 };
@@ -0,0 +1,130 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrikesBenchmark.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** Longest a scenario may take before the test gives up on it, in seconds */
+	constexpr double BenchmarkTimeout = 300.0;
+
+	/** The running game world that can spawn gameplay actors, or null */
+	UWorld* FindBenchmarkWorld()
+	{
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			UWorld* World = Context.World();
+			if (World != nullptr && (Context.WorldType == EWorldType::Game || Context.WorldType == EWorldType::PIE) &&
+				World->GetNetMode() != NM_Client && World->HasBegunPlay())
+			{
+				return World;
+			}
+		}
+		return nullptr;
+	}
+}
+
+/** Waits for the benchmark subsystem to finish its run, then reports the result and its regressions */
+class FStrikesWaitForBenchmarkCommand : public IAutomationLatentCommand
+{
+public:
+	FStrikesWaitForBenchmarkCommand(FAutomationTestBase* InTest, UStrikesBenchmarkSubsystem* InBenchmark)
+		: Test(InTest)
+		, Benchmark(InBenchmark)
+	{
+	}
+
+	virtual bool Update() override
+	{
+		if (!Benchmark.IsValid())
+		{
+			Test->AddError(TEXT("The world running the benchmark went away"));
+			return true;
+		}
+
+		if (Benchmark->IsRunning())
+		{
+			if (GetCurrentRunTime() > BenchmarkTimeout)
+			{
+				Test->AddError(FString::Printf(TEXT("Benchmark did not finish within %.0f s"), BenchmarkTimeout));
+				return true;
+			}
+			return false;
+		}
+
+		if (Benchmark->GetResults().Num() == 0)
+		{
+			Test->AddError(TEXT("Benchmark finished without a result"));
+			return true;
+		}
+
+		const FStrikesBenchmarkResult& Result = Benchmark->GetResults().Last();
+		const TCHAR* Name = UStrikesBenchmarkSubsystem::GetScenarioName(Result.Scenario);
+		Test->AddInfo(FString::Printf(TEXT("%s: %.3f ms avg, %.3f ms p95, %.1f MiB, %d objects"), Name,
+		                              Result.GameThreadMsAvg, Result.GameThreadMsP95, Result.MemoryMB, Result.Objects));
+
+		if (Benchmark->FindBaseline(Result.Scenario) == nullptr)
+		{
+			Test->AddError(FString::Printf(TEXT("%s has no baseline; record one with -StrikesBenchmarkRecord"), Name));
+		}
+
+		for (const FString& Regression : Benchmark->FindRegressions(Result))
+		{
+			Test->AddError(Regression);
+		}
+		return true;
+	}
+
+private:
+	FAutomationTestBase* Test;
+	TWeakObjectPtr<UStrikesBenchmarkSubsystem> Benchmark;
+};
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FStrikesBenchmarkTest, "Strikes.Benchmark",
+                                  EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+void FStrikesBenchmarkTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (const EStrikesBenchmarkScenario Scenario : UStrikesBenchmarkSubsystem::GetAllScenarios())
+	{
+		OutBeautifiedNames.Add(UStrikesBenchmarkSubsystem::GetScenarioName(Scenario));
+		OutTestCommands.Add(UStrikesBenchmarkSubsystem::GetScenarioName(Scenario));
+	}
+}
+
+bool FStrikesBenchmarkTest::RunTest(const FString& Parameters)
+{
+	// Scenarios spawn into the running game, e.g. StrikesServer FirstPersonMap -nullrhi
+	UWorld* World = FindBenchmarkWorld();
+	if (World == nullptr)
+	{
+		AddError(TEXT("No game world to run the benchmark in; start the game or server with a map"));
+		return false;
+	}
+
+	UStrikesBenchmarkSubsystem* Benchmark = World->GetSubsystem<UStrikesBenchmarkSubsystem>();
+	if (!TestNotNull(TEXT("Benchmark subsystem"), Benchmark) ||
+		!TestFalse(TEXT("No -StrikesBenchmark run in progress"), Benchmark->IsRunning()))
+	{
+		return false;
+	}
+
+	for (const EStrikesBenchmarkScenario Scenario : UStrikesBenchmarkSubsystem::GetAllScenarios())
+	{
+		if (Parameters == UStrikesBenchmarkSubsystem::GetScenarioName(Scenario))
+		{
+			Benchmark->Run({Scenario}, false);
+			ADD_LATENT_AUTOMATION_COMMAND(FStrikesWaitForBenchmarkCommand(this, Benchmark));
+			return true;
+		}
+	}
+
+	AddError(FString::Printf(TEXT("Unknown benchmark scenario '%s'"), *Parameters));
+	return false;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CampFire.h"
+#include "StrikesBots.h"
+#include "StrikesCharacter.h"
+#include "StrikesDamageZones.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** The running game world on the server, with a game mode that lets pawns take damage, or null */
+	UWorld* FindServerGameWorld()
+	{
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			UWorld* World = Context.World();
+			if (World != nullptr && (Context.WorldType == EWorldType::Game || Context.WorldType == EWorldType::PIE) &&
+				World->GetAuthGameMode() != nullptr && World->HasBegunPlay())
+			{
+				return World;
+			}
+		}
+		return nullptr;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStrikesDamageZoneBotMetricsTest, "Strikes.DamageZones.BotMetrics",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FStrikesDamageZoneBotMetricsTest::RunTest(const FString& Parameters)
+{
+	// Pawns only take damage with a game mode, e.g. StrikesServer FirstPersonMap -nullrhi
+	UWorld* World = FindServerGameWorld();
+	if (World == nullptr)
+	{
+		AddError(TEXT("No server game world to damage a character in; start the game or server with a map"));
+		return false;
+	}
+
+	UStrikesDamageZoneSubsystem* DamageZones = World->GetSubsystem<UStrikesDamageZoneSubsystem>();
+	UStrikesBotSubsystem* BotSubsystem = World->GetSubsystem<UStrikesBotSubsystem>();
+
+	// Far below the level, so nothing else overlaps the fire or the character
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	ACampFire* Fire = World->SpawnActor<ACampFire>(FVector(0.0, 0.0, -100000.0), FRotator::ZeroRotator, SpawnParams);
+	AStrikesCharacter* Character = World->SpawnActor<AStrikesCharacter>(FVector(1000.0, 0.0, -100000.0),
+	                                                                   FRotator::ZeroRotator, SpawnParams);
+
+	if (TestNotNull(TEXT("Damage zone subsystem"), DamageZones) && TestNotNull(TEXT("Bot subsystem"), BotSubsystem) &&
+		TestNotNull(TEXT("Fire"), Fire) && TestNotNull(TEXT("Character"), Character))
+	{
+		TestTrue(TEXT("The fire damages characters in the store pass"), !Fire->bSendDamageEvents);
+
+		BotSubsystem->TrackBotCharacter(Character);
+		const int32 DamageEventsBefore = BotSubsystem->GetDamageEvents();
+		const float DamageTakenBefore = BotSubsystem->GetDamageTaken();
+		const float HealthBefore = Character->GetHealth();
+
+		// The first tick is due on the next pass
+		DamageZones->AddVictim(Fire, Character, FHitResult());
+		DamageZones->Tick(0.f);
+
+		TestTrue(TEXT("The store pass damaged the character"), Character->GetHealth() < HealthBefore);
+		TestEqual(TEXT("Bots counted one damage event"), BotSubsystem->GetDamageEvents() - DamageEventsBefore, 1);
+		TestEqual(TEXT("Bots counted the fire's damage"), BotSubsystem->GetDamageTaken() - DamageTakenBefore,
+		          Fire->DamageAmount);
+
+		DamageZones->RemoveZone(Fire);
+	}
+
+	if (Character != nullptr)
+	{
+		Character->Destroy();
+	}
+	if (Fire != nullptr)
+	{
+		Fire->Destroy();
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrikesCharacter.h"
+#include "StrikesLagCompensation.h"
+#include "StrikesProjectile.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStrikesLagCompensationResolveShotTest, "Strikes.LagComp.ResolveShot",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FStrikesLagCompensationResolveShotTest::RunTest(const FString& Parameters)
+{
+	constexpr double FrameTime = 1.0 / 60.0;
+	constexpr double TargetSpeed = 600.0;
+	constexpr double Latency = 0.15;
+	constexpr int32 NumFrames = 60;
+
+	// An empty game world, with the lag compensation subsystem, and one character running along X
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	UStrikesLagCompensationSubsystem* LagCompensation = World->GetSubsystem<UStrikesLagCompensationSubsystem>();
+	AStrikesCharacter* Target = World->SpawnActor<AStrikesCharacter>();
+
+	if (TestNotNull(TEXT("Lag compensation subsystem"), LagCompensation) && TestNotNull(TEXT("Target"), Target))
+	{
+		// Record the history the way the server does: the subsystem samples every character once per frame
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			World->TimeSeconds = Frame * FrameTime;
+			Target->SetActorLocation(FVector(Frame * FrameTime * TargetSpeed, 0.0, 100.0), false, nullptr,
+			                         ETeleportType::TeleportPhysics);
+			LagCompensation->Tick(FrameTime);
+		}
+
+		const FStrikesHitboxHistory* History = LagCompensation->FindHistory(Target);
+		if (TestNotNull(TEXT("Target history"), History))
+		{
+			TestEqual(TEXT("One sample per frame"), History->Num(), NumFrames);
+		}
+
+		// The shooter saw the target Latency ago and fires across where it was then, from 1000 uu to the side
+		const double Now = World->GetTimeSeconds();
+		const double ShotTime = Now - Latency;
+		const FVector Start(ShotTime * TargetSpeed, -1000.0, 100.0);
+		const FVector End = Start + FVector(0.0, 2000.0, 0.0);
+
+		ECollisionChannel Channel;
+		FCollisionResponseParams ResponseParams;
+		AStrikesProjectile::GetCollisionChannelAndResponse(Channel, ResponseParams);
+
+		FHitResult WorldHit;
+		FVector HitLocation;
+		const AStrikesCharacter* RewoundTarget = LagCompensation->ResolveShot(
+			Start, End, ShotTime, nullptr, Channel, ResponseParams, WorldHit, HitLocation);
+		TestTrue(TEXT("The shot hits the capsule rewound by the delay"), RewoundTarget == Target);
+
+		// The capsule is entered on the shooter's side, one radius before its axis
+		const float Radius = Target->GetCapsuleComponent()->GetScaledCapsuleRadius();
+		TestEqual(TEXT("Hit location is on the rewound capsule"), HitLocation.Y, -static_cast<double>(Radius), 1.0);
+
+		// The target moved further than its radius since, so the shot misses it where it is now
+		const AStrikesCharacter* CurrentTarget = LagCompensation->ResolveShot(
+			Start, End, Now, nullptr, Channel, ResponseParams, WorldHit, HitLocation);
+		TestNull(TEXT("The same shot misses the capsule without rewinding"), CurrentTarget);
+
+		// The shooter is never hit by its own shot
+		const AStrikesCharacter* SelfTarget = LagCompensation->ResolveShot(
+			Start, End, ShotTime, Target, Channel, ResponseParams, WorldHit, HitLocation);
+		TestNull(TEXT("The instigator is ignored"), SelfTarget);
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
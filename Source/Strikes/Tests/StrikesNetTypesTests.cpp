@@ -0,0 +1,190 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrikesNetTypes.h"
+#include "Engine/NetSerialization.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/**
+	 * Writes values the way property replication sends changed properties without a custom serializer:
+	 * a packed property handle in front of every value, at full precision.
+	 */
+	class FStrikesNaiveNetWriter
+	{
+	public:
+		FStrikesNaiveNetWriter()
+			: Writer(0, true)
+		{
+		}
+
+		template <typename T>
+		void Add(T Value)
+		{
+			WriteHandle();
+			Writer << Value;
+		}
+
+		void Add(const bool bValue)
+		{
+			WriteHandle();
+			Writer.WriteBit(bValue);
+		}
+
+		int64 GetNumBits() const { return Writer.GetNumBits(); }
+
+	private:
+		void WriteHandle()
+		{
+			Writer.SerializeIntPacked(NextHandle);
+			++NextHandle;
+		}
+
+		FBitWriter Writer;
+		uint32 NextHandle = 1;
+	};
+
+	/** Bits of the packed handle in front of a replicated property or struct */
+	int64 GetHandleBits()
+	{
+		FBitWriter Writer(0, true);
+		uint32 Handle = 1;
+		Writer.SerializeIntPacked(Handle);
+		return Writer.GetNumBits();
+	}
+
+	/** Writes a struct with its NetSerialize and returns the bits it took */
+	template <typename T>
+	int64 WriteNetSerialize(T& Value, FBitWriter& Writer)
+	{
+		bool bSuccess = true;
+		Value.NetSerialize(Writer, nullptr, bSuccess);
+		return Writer.GetNumBits();
+	}
+
+	/** Reads back what WriteNetSerialize wrote */
+	template <typename T>
+	T ReadNetSerialize(const FBitWriter& Writer)
+	{
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		T Value;
+		bool bSuccess = true;
+		Value.NetSerialize(Reader, nullptr, bSuccess);
+		return Value;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStrikesNetSerializationTest, "Strikes.Net.Serialization",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FStrikesNetSerializationTest::RunTest(const FString& Parameters)
+{
+	// A percentage may be off by half a quantization step
+	const float PercentageTolerance = 0.5f / ((1 << StrikesNet::PercentageBits) - 1);
+
+	// The quantized structs replicate as one property each, so they pay for one handle
+	const int64 HandleBits = GetHandleBits();
+
+	// Health: the quantized struct against the health and percentage floats it replaced
+	{
+		FStrikesNaiveNetWriter Naive;
+		Naive.Add(73.4f);
+		Naive.Add(0.734f);
+
+		FStrikesNetHealth Health;
+		Health.HealthPercentage = 0.734f;
+
+		FBitWriter Writer(0, true);
+		const int64 QuantizedBits = HandleBits + WriteNetSerialize(Health, Writer);
+
+		AddInfo(FString::Printf(TEXT("Health: %lld -> %lld bits"), Naive.GetNumBits(), QuantizedBits));
+		TestTrue(TEXT("Health is smaller quantized"), QuantizedBits < Naive.GetNumBits());
+
+		const FStrikesNetHealth Read = ReadNetSerialize<FStrikesNetHealth>(Writer);
+		TestEqual(TEXT("Health percentage survives quantization"), Read.HealthPercentage, Health.HealthPercentage,
+		          PercentageTolerance);
+	}
+
+	// Magic: the quantized struct against the floats, timestamps, flags and prediction key it replaced
+	{
+		FStrikesNetMagic Magic;
+		Magic.MagicFraction = 0.8f;
+		Magic.MagicPercentage = 0.8f;
+		Magic.PreviousMagic = 1.f;
+		Magic.MagicValue = -0.2f;
+		Magic.MagicCurveStartTime = 123.4f;
+		Magic.MagicUsableTime = 128.4f;
+		Magic.MagicRegenTime = 128.4f;
+		Magic.bMagicCurvePlaying = true;
+		Magic.bMagicRegenPending = true;
+		Magic.AckedPredictionKey = 42;
+		Magic.bAckedPredictionFired = true;
+
+		FStrikesNaiveNetWriter Naive;
+		Naive.Add(Magic.MagicFraction * 100.f);
+		Naive.Add(Magic.MagicPercentage);
+		Naive.Add(Magic.PreviousMagic);
+		Naive.Add(Magic.MagicValue);
+		Naive.Add(static_cast<double>(Magic.MagicCurveStartTime));
+		Naive.Add(static_cast<double>(Magic.MagicUsableTime));
+		Naive.Add(static_cast<double>(Magic.MagicRegenTime));
+		Naive.Add(Magic.bMagicCurvePlaying);
+		Naive.Add(Magic.bMagicRegenPending);
+		Naive.Add(Magic.AckedPredictionKey);
+		Naive.Add(Magic.bAckedPredictionFired);
+
+		FBitWriter Writer(0, true);
+		const int64 QuantizedBits = HandleBits + WriteNetSerialize(Magic, Writer);
+
+		AddInfo(FString::Printf(TEXT("Magic: %lld -> %lld bits"), Naive.GetNumBits(), QuantizedBits));
+		TestTrue(TEXT("Magic is smaller quantized"), QuantizedBits < Naive.GetNumBits());
+
+		const FStrikesNetMagic Read = ReadNetSerialize<FStrikesNetMagic>(Writer);
+		TestEqual(TEXT("Magic fraction survives quantization"), Read.MagicFraction, Magic.MagicFraction,
+		          PercentageTolerance);
+		TestEqual(TEXT("Magic value survives quantization"), Read.MagicValue, Magic.MagicValue,
+		          2.f * PercentageTolerance);
+		TestEqual(TEXT("Curve start time is exact"), Read.MagicCurveStartTime, Magic.MagicCurveStartTime);
+		TestEqual(TEXT("Regen time is exact"), Read.MagicRegenTime, Magic.MagicRegenTime);
+		TestEqual(TEXT("Prediction key is exact"), static_cast<int32>(Read.AckedPredictionKey),
+		          static_cast<int32>(Magic.AckedPredictionKey));
+		TestTrue(TEXT("Prediction fired flag is kept"), Read.bAckedPredictionFired);
+	}
+
+	// Projectile spawn: the launch against the replicated movement an actor per bolt sends at least
+	{
+		FRepMovement Movement;
+		Movement.Location = FVector(1234.5, -678.9, 150.2);
+		Movement.Rotation = FRotator(-3.f, 87.5f, 0.f);
+		Movement.LinearVelocity = Movement.Rotation.Vector() * 3000.f;
+
+		FBitWriter MovementWriter(0, true);
+		bool bMovementSuccess = true;
+		Movement.NetSerialize(MovementWriter, nullptr, bMovementSuccess);
+		const int64 NaiveBits = MovementWriter.GetNumBits();
+
+		FStrikesNetProjectileSpawn Spawn;
+		Spawn.Origin = Movement.Location;
+		Spawn.Direction = Movement.Rotation.Vector();
+		Spawn.SpawnTime = 123.4f;
+
+		FBitWriter Writer(0, true);
+		const int64 QuantizedBits = WriteNetSerialize(Spawn, Writer);
+
+		AddInfo(FString::Printf(TEXT("Projectile spawn: %lld+ (actor movement only) -> %lld bits"), NaiveBits,
+		                        QuantizedBits));
+		TestTrue(TEXT("Projectile spawn is smaller than actor movement"), QuantizedBits < NaiveBits);
+
+		const FStrikesNetProjectileSpawn Read = ReadNetSerialize<FStrikesNetProjectileSpawn>(Writer);
+		TestTrue(TEXT("Origin survives quantization"), Read.Origin.Equals(Spawn.Origin, 0.1));
+		TestTrue(TEXT("Direction survives quantization"), Read.Direction.Equals(Spawn.Direction, 0.001));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
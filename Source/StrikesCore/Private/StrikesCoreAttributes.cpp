@@ -0,0 +1,192 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrikesCoreAttributes.h"
+
+FStrikesAttributeHandle FStrikesAttributeStore::Add(const FStrikesHealthState& InHealth,
+                                                    const FStrikesMagicState& InMagic,
+                                                    const FStrikesMagicRules& Rules)
+{
+	int32 Slot;
+	if (FreeSlots.Num() > 0)
+	{
+		Slot = FreeSlots.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		Slot = SlotToDense.Add(INDEX_NONE);
+		SlotGeneration.Add(0);
+	}
+
+	const int32 Index = Num();
+	ForEachColumn([](auto& Column) { Column.AddDefaulted(); });
+
+	DenseToSlot[Index] = Slot;
+	SlotToDense[Slot] = Index;
+	SetHealth(Index, InHealth);
+	SetMagic(Index, InMagic);
+	MagicRules[Index] = Rules;
+
+	FStrikesAttributeHandle Handle;
+	Handle.Slot = Slot;
+	Handle.Generation = SlotGeneration[Slot];
+	return Handle;
+}
+
+void FStrikesAttributeStore::Remove(const FStrikesAttributeHandle Handle)
+{
+	const int32 Index = GetIndex(Handle);
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	// The last combatant takes the place of the removed one
+	const int32 LastSlot = DenseToSlot.Last();
+	ForEachColumn([Index](auto& Column) { Column.RemoveAtSwap(Index, 1, EAllowShrinking::No); });
+	if (LastSlot != Handle.Slot)
+	{
+		SlotToDense[LastSlot] = Index;
+	}
+
+	SlotToDense[Handle.Slot] = INDEX_NONE;
+	++SlotGeneration[Handle.Slot];
+	FreeSlots.Add(Handle.Slot);
+}
+
+int32 FStrikesAttributeStore::GetIndex(const FStrikesAttributeHandle Handle) const
+{
+	if (!SlotToDense.IsValidIndex(Handle.Slot) || SlotGeneration[Handle.Slot] != Handle.Generation)
+	{
+		return INDEX_NONE;
+	}
+
+	return SlotToDense[Handle.Slot];
+}
+
+FStrikesAttributeHandle FStrikesAttributeStore::GetHandle(const int32 Index) const
+{
+	FStrikesAttributeHandle Handle;
+	Handle.Slot = DenseToSlot[Index];
+	Handle.Generation = SlotGeneration[Handle.Slot];
+	return Handle;
+}
+
+FStrikesHealthState FStrikesAttributeStore::GetHealth(const int32 Index) const
+{
+	FStrikesHealthState State;
+	State.FullHealth = FullHealth[Index];
+	State.Health = Health[Index];
+	State.Percentage = HealthPercentage[Index];
+	State.PreviousPercentage = PreviousHealth[Index];
+	State.InvincibleUntilTime = InvincibleUntilTime[Index];
+	State.bRedFlash = bRedFlash[Index];
+	return State;
+}
+
+void FStrikesAttributeStore::SetHealth(const int32 Index, const FStrikesHealthState& State)
+{
+	FullHealth[Index] = State.FullHealth;
+	Health[Index] = State.Health;
+	HealthPercentage[Index] = State.Percentage;
+	PreviousHealth[Index] = State.PreviousPercentage;
+	InvincibleUntilTime[Index] = State.InvincibleUntilTime;
+	bRedFlash[Index] = State.bRedFlash;
+}
+
+FStrikesMagicState FStrikesAttributeStore::GetMagic(const int32 Index) const
+{
+	FStrikesMagicState State;
+	State.Magic = Magic[Index];
+	State.Percentage = MagicPercentage[Index];
+	State.PreviousPercentage = PreviousMagic[Index];
+	State.CurveDelta = MagicCurveDelta[Index];
+	State.CurveStartTime = MagicCurveStartTime[Index];
+	State.UsableTime = MagicUsableTime[Index];
+	State.RegenTime = MagicRegenTime[Index];
+	State.bCurvePlaying = bMagicCurvePlaying[Index];
+	State.bRegenPending = bMagicRegenPending[Index];
+	State.bCoolingDown = bMagicCoolingDown[Index];
+	return State;
+}
+
+void FStrikesAttributeStore::SetMagic(const int32 Index, const FStrikesMagicState& State)
+{
+	Magic[Index] = State.Magic;
+	MagicPercentage[Index] = State.Percentage;
+	PreviousMagic[Index] = State.PreviousPercentage;
+	MagicCurveDelta[Index] = State.CurveDelta;
+	MagicCurveStartTime[Index] = State.CurveStartTime;
+	MagicUsableTime[Index] = State.UsableTime;
+	MagicRegenTime[Index] = State.RegenTime;
+	bMagicCurvePlaying[Index] = State.bCurvePlaying;
+	bMagicRegenPending[Index] = State.bRegenPending;
+	bMagicCoolingDown[Index] = State.bCoolingDown;
+}
+
+void FStrikesAttributeStore::SettleMagic(const double Now, TArray<int32>& OutChanged)
+{
+	for (int32 Index = 0; Index < Num(); ++Index)
+	{
+		// Most combatants have nothing due, so only the timestamps are read for them
+		const bool bRegenDue = bMagicRegenPending[Index] && Now >= MagicRegenTime[Index];
+		const bool bCurveDone = bMagicCurvePlaying[Index] &&
+			Now >= MagicCurveStartTime[Index] + MagicRules[Index].CurveLength;
+		const bool bCooldownDone = bMagicCoolingDown[Index] && Now >= MagicUsableTime[Index];
+		if (!bRegenDue && !bCurveDone && !bCooldownDone)
+		{
+			continue;
+		}
+
+		FStrikesMagicState State = GetMagic(Index);
+		StrikesMagic::Settle(State, MagicRules[Index], Now);
+		SetMagic(Index, State);
+		OutChanged.Add(Index);
+	}
+}
+
+void FStrikesAttributeStore::TakeDamage(TConstArrayView<float> Damage, const float InvincibilityDuration,
+                                        const double Now, TArray<int32>& OutDied)
+{
+	check(Damage.Num() == Num());
+
+	// Branch-free over the health arrays, so the compiler can vectorize it
+	const double InvincibleUntil = Now + InvincibilityDuration;
+	for (int32 Index = 0; Index < Num(); ++Index)
+	{
+		const bool bDamaged = Damage[Index] > 0.f;
+		const float NewHealth = FMath::Clamp(Health[Index] - Damage[Index], 0.f, FullHealth[Index]);
+
+		PreviousHealth[Index] = bDamaged ? HealthPercentage[Index] : PreviousHealth[Index];
+		Health[Index] = bDamaged ? NewHealth : Health[Index];
+		HealthPercentage[Index] = Health[Index] / FullHealth[Index];
+		InvincibleUntilTime[Index] = bDamaged ? InvincibleUntil : InvincibleUntilTime[Index];
+		bRedFlash[Index] = bRedFlash[Index] || bDamaged;
+	}
+
+	// Only the damage that takes health down to zero counts as a death
+	for (int32 Index = 0; Index < Num(); ++Index)
+	{
+		if (Damage[Index] > 0.f && FMath::IsNearlyZero(HealthPercentage[Index], 0.001f) &&
+			!FMath::IsNearlyZero(PreviousHealth[Index], 0.001f))
+		{
+			OutDied.Add(Index);
+		}
+	}
+}
+
+void FStrikesAttributeStore::GetMagicPercentages(const double Now, TArrayView<float> OutPercentages) const
+{
+	check(OutPercentages.Num() == Num());
+
+	for (int32 Index = 0; Index < Num(); ++Index)
+	{
+		const FStrikesMagicRules& Rules = MagicRules[Index];
+		const bool bCurveDriven = Rules.Curve != nullptr &&
+			(bMagicCurvePlaying[Index] || (bMagicRegenPending[Index] && Now >= MagicRegenTime[Index]));
+
+		// Settled combatants are read straight from the percentage array
+		OutPercentages[Index] = bCurveDriven
+			                        ? FMath::Clamp(StrikesMagic::Evaluate(GetMagic(Index), Rules, Now), 0.f, 1.f)
+			                        : MagicPercentage[Index];
+	}
+}
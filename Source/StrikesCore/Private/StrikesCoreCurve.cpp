@@ -0,0 +1,27 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrikesCoreCurve.h"
+
+float FStrikesCoreCurve::Evaluate(const float Time) const
+{
+	const int32 NumSamples = Samples.Num();
+	if (NumSamples == 0)
+	{
+		return 0.f;
+	}
+
+	if (Length <= 0.f || Time >= Length)
+	{
+		return Samples[NumSamples - 1];
+	}
+
+	if (Time <= 0.f)
+	{
+		return Samples[0];
+	}
+
+	const float Position = Time / Length * (NumSamples - 1);
+	const int32 Index = FMath::Min(FMath::FloorToInt32(Position), NumSamples - 2);
+
+	return FMath::Lerp(Samples[Index], Samples[Index + 1], Position - Index);
+}
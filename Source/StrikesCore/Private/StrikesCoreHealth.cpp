@@ -0,0 +1,63 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrikesCoreHealth.h"
+
+void StrikesHealth::Reset(FStrikesHealthState& State, const float FullHealth)
+{
+	State.FullHealth = FullHealth;
+	State.Health = FullHealth;
+	State.Percentage = 1.f;
+	State.PreviousPercentage = 1.f;
+	State.InvincibleUntilTime = 0.0;
+	State.bRedFlash = false;
+}
+
+EStrikesHealthChange StrikesHealth::Apply(FStrikesHealthState& State, const float Change)
+{
+	State.Health = FMath::Clamp(State.Health + Change, 0.f, State.FullHealth);
+	State.PreviousPercentage = State.Percentage;
+	State.Percentage = State.Health / State.FullHealth;
+
+	if (State.Percentage == State.PreviousPercentage)
+	{
+		return EStrikesHealthChange::ENone;
+	}
+
+	// Only the change that takes health down to zero counts as a death
+	if (FMath::IsNearlyZero(State.Percentage, 0.001f) && !FMath::IsNearlyZero(State.PreviousPercentage, 0.001f))
+	{
+		return EStrikesHealthChange::EDied;
+	}
+
+	return EStrikesHealthChange::EChanged;
+}
+
+EStrikesHealthChange StrikesHealth::TakeDamage(FStrikesHealthState& State, const float Damage,
+                                               const float InvincibilityDuration, const double Now)
+{
+	if (!IsDamageable(State, Now))
+	{
+		return EStrikesHealthChange::ENone;
+	}
+
+	State.bRedFlash = true;
+	const EStrikesHealthChange Change = Apply(State, -Damage);
+	StartInvincibility(State, InvincibilityDuration, Now);
+
+	return Change;
+}
+
+void StrikesHealth::TakeDamageAll(TArrayView<FStrikesHealthState> States, TConstArrayView<float> Damage,
+                                  const float InvincibilityDuration, const double Now, TArray<int32>& OutDied)
+{
+	check(States.Num() == Damage.Num());
+
+	for (int32 Index = 0; Index < States.Num(); ++Index)
+	{
+		if (Damage[Index] > 0.f &&
+			TakeDamage(States[Index], Damage[Index], InvincibilityDuration, Now) == EStrikesHealthChange::EDied)
+		{
+			OutDied.Add(Index);
+		}
+	}
+}
@@ -0,0 +1,252 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StrikesCoreMagic.h"
+#include "StrikesCoreCurve.h"
+
+namespace
+{
+	/** Stores a curve value as the current percentage and amount */
+	void StoreValue(FStrikesMagicState& State, const FStrikesMagicRules& Rules, const float CurveValue)
+	{
+		State.Magic = FMath::Clamp(CurveValue * Rules.AmountScale, 0.f, Rules.FullMagic);
+		State.Percentage = FMath::Clamp(CurveValue, 0.f, 1.f);
+	}
+}
+
+void StrikesMagic::Reset(FStrikesMagicState& State, const FStrikesMagicRules& Rules)
+{
+	State.Magic = Rules.FullMagic;
+	State.Percentage = 1.f;
+	State.PreviousPercentage = 1.f;
+	State.CurveDelta = 0.f;
+	State.UsableTime = 0.0;
+	State.bRegenPending = false;
+	State.bCurvePlaying = false;
+	State.bCoolingDown = false;
+}
+
+float StrikesMagic::SampleCurve(const FStrikesMagicRules& Rules, const float From, const float Delta,
+                                const double StartTime, const double Time)
+{
+	// Sampled at the time elapsed since the curve started, holding the last value once it has finished
+	const float Position = FMath::Clamp(static_cast<float>(Time - StartTime), 0.f, Rules.CurveLength);
+
+	// Without a curve a change is complete as soon as it starts
+	return From + Delta * (Rules.Curve != nullptr ? Rules.Curve->Evaluate(Position) : 1.f);
+}
+
+float StrikesMagic::Evaluate(const FStrikesMagicState& State, const FStrikesMagicRules& Rules, const double Now)
+{
+	if (State.bRegenPending && Now >= State.RegenTime)
+	{
+		// Regeneration has started: it runs from the value reached when it began, as Update would
+		const float RegenFrom = State.bCurvePlaying
+			                        ? FMath::Clamp(SampleCurve(Rules, State.PreviousPercentage, State.CurveDelta,
+			                                                   State.CurveStartTime, State.RegenTime), 0.f, 1.f)
+			                        : State.Percentage;
+
+		return SampleCurve(Rules, RegenFrom, 1.f, State.RegenTime, Now);
+	}
+
+	return SampleCurve(Rules, State.PreviousPercentage, State.CurveDelta, State.CurveStartTime, Now);
+}
+
+bool StrikesMagic::IsCurveDriven(const FStrikesMagicState& State, const FStrikesMagicRules& Rules, const double Now)
+{
+	return Rules.Curve != nullptr && (State.bCurvePlaying || (State.bRegenPending && Now >= State.RegenTime));
+}
+
+bool StrikesMagic::IsAnimating(const FStrikesMagicState& State, const FStrikesMagicRules& Rules, const double Now)
+{
+	if (Rules.Curve == nullptr)
+	{
+		return false;
+	}
+
+	// Regeneration plays the curve once more, starting at RegenTime
+	if (State.bRegenPending)
+	{
+		return Now < State.RegenTime + Rules.CurveLength;
+	}
+
+	return State.bCurvePlaying && Now < State.CurveStartTime + Rules.CurveLength;
+}
+
+float StrikesMagic::GetPercentage(const FStrikesMagicState& State, const FStrikesMagicRules& Rules, const double Now)
+{
+	if (IsCurveDriven(State, Rules, Now))
+	{
+		return FMath::Clamp(Evaluate(State, Rules, Now), 0.f, 1.f);
+	}
+
+	return State.Percentage;
+}
+
+float StrikesMagic::GetAmount(const FStrikesMagicState& State, const FStrikesMagicRules& Rules, const double Now)
+{
+	if (IsCurveDriven(State, Rules, Now))
+	{
+		return FMath::Clamp(Evaluate(State, Rules, Now) * Rules.AmountScale, 0.f, Rules.FullMagic);
+	}
+
+	return State.Magic;
+}
+
+bool StrikesMagic::CanFire(const FStrikesMagicState& State, const FStrikesMagicRules& Rules, const double Now)
+{
+	// A spend counts as soon as it is made, not once the curve has shown it
+	float Amount = GetAmount(State, Rules, Now);
+	if (State.bCurvePlaying && State.CurveDelta < 0.f && !(State.bRegenPending && Now >= State.RegenTime))
+	{
+		const float Target = State.PreviousPercentage + State.CurveDelta;
+		Amount = FMath::Min(Amount, FMath::Clamp(Target * Rules.AmountScale, 0.f, Rules.FullMagic));
+	}
+
+	return !FMath::IsNearlyZero(Amount, 0.001f);
+}
+
+void StrikesMagic::StoreCurveValue(FStrikesMagicState& State, const FStrikesMagicRules& Rules, const double Now)
+{
+	StoreValue(State, Rules, Evaluate(State, Rules, Now));
+}
+
+bool StrikesMagic::Settle(FStrikesMagicState& State, const FStrikesMagicRules& Rules, const double Now)
+{
+	bool bChanged = false;
+
+	if (State.bRegenPending && Now >= State.RegenTime)
+	{
+		State.bRegenPending = false;
+
+		// Store the value the previous curve had reached when regeneration started
+		if (State.bCurvePlaying)
+		{
+			StoreValue(State, Rules, SampleCurve(Rules, State.PreviousPercentage, State.CurveDelta,
+			                                     State.CurveStartTime, State.RegenTime));
+		}
+
+		// Same as Update, but started at the time regeneration was due
+		State.PreviousPercentage = State.Percentage;
+		State.Percentage = State.Magic / Rules.FullMagic;
+		State.CurveDelta = 1.f;
+		State.CurveStartTime = State.RegenTime;
+		State.bCurvePlaying = Rules.Curve != nullptr;
+		bChanged = true;
+	}
+
+	if (State.bCurvePlaying && Now >= State.CurveStartTime + Rules.CurveLength)
+	{
+		// The curve has finished: store its final value and clear the change, as ResetCooldown does
+		StoreCurveValue(State, Rules, Now);
+		State.bCurvePlaying = false;
+		State.CurveDelta = 0.f;
+		bChanged = true;
+	}
+
+	if (State.bCoolingDown && Now >= State.UsableTime)
+	{
+		State.bCoolingDown = false;
+		bChanged = true;
+	}
+
+	return bChanged;
+}
+
+bool StrikesMagic::PlayCurve(FStrikesMagicState& State, const FStrikesMagicRules& Rules, const double Now)
+{
+	if (Rules.Curve == nullptr)
+	{
+		return false;
+	}
+
+	State.CurveStartTime = Now;
+	State.bCurvePlaying = true;
+	return true;
+}
+
+bool StrikesMagic::StopCurve(FStrikesMagicState& State, const FStrikesMagicRules& Rules, const double Now)
+{
+	// Apply anything that has already happened, then keep the value reached so far
+	const bool bSettled = Settle(State, Rules, Now);
+
+	if (!State.bCurvePlaying)
+	{
+		return bSettled;
+	}
+
+	StoreCurveValue(State, Rules, Now);
+	State.bCurvePlaying = false;
+	return true;
+}
+
+bool StrikesMagic::Update(FStrikesMagicState& State, const FStrikesMagicRules& Rules, const double Now)
+{
+	StopCurve(State, Rules, Now);
+	State.PreviousPercentage = State.Percentage;
+	State.Percentage = State.Magic / Rules.FullMagic;
+	State.CurveDelta = 1.f;
+
+	return PlayCurve(State, Rules, Now);
+}
+
+bool StrikesMagic::Change(FStrikesMagicState& State, const FStrikesMagicRules& Rules, const float Amount,
+                          const double Now)
+{
+	Settle(State, Rules, Now);
+
+	// Part of a spend the interrupted curve hasn't reached yet; regeneration left over is dropped instead
+	const float Remaining = State.bCurvePlaying
+		                        ? FMath::Min(State.PreviousPercentage + State.CurveDelta - Evaluate(State, Rules, Now), 0.f)
+		                        : 0.f;
+
+	StopCurve(State, Rules, Now);
+	State.PreviousPercentage = State.Percentage;
+	State.CurveDelta = Remaining + Amount / Rules.FullMagic;
+
+	// Magic can be used again once the curve has played
+	State.UsableTime = Now + Rules.CurveLength;
+	State.bCoolingDown = true;
+
+	return PlayCurve(State, Rules, Now);
+}
+
+bool StrikesMagic::Spend(FStrikesMagicState& State, const FStrikesMagicRules& Rules, const double Now)
+{
+	const bool bCurveStarted = Change(State, Rules, -Rules.SpendPerShot, Now);
+
+	// Regeneration is applied lazily the next time magic is read or settled
+	State.RegenTime = Now + Rules.RegenDelay;
+	State.bRegenPending = true;
+
+	return bCurveStarted;
+}
+
+void StrikesMagic::ResetCooldown(FStrikesMagicState& State, const FStrikesMagicRules& Rules, const double Now)
+{
+	Settle(State, Rules, Now);
+	State.UsableTime = 0.0;
+	State.bCoolingDown = false;
+	State.CurveDelta = 0.f;
+}
+
+int32 StrikesMagic::SettleAll(TArrayView<FStrikesMagicState> States, const FStrikesMagicRules& Rules,
+                              const double Now)
+{
+	int32 NumChanged = 0;
+	for (FStrikesMagicState& State : States)
+	{
+		NumChanged += Settle(State, Rules, Now) ? 1 : 0;
+	}
+	return NumChanged;
+}
+
+void StrikesMagic::GetPercentageAll(TConstArrayView<FStrikesMagicState> States, const FStrikesMagicRules& Rules,
+                                    const double Now, TArrayView<float> OutPercentages)
+{
+	check(States.Num() == OutPercentages.Num());
+
+	for (int32 Index = 0; Index < States.Num(); ++Index)
+	{
+		OutPercentages[Index] = GetPercentage(States[Index], Rules, Now);
+	}
+}
@@ -0,0 +1,175 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StrikesCoreHealth.h"
+#include "StrikesCoreMagic.h"
+
+/** Refers to one combatant of an FStrikesAttributeStore; stays valid until the combatant is removed */
+struct FStrikesAttributeHandle
+{
+	/** Slot of the combatant, or INDEX_NONE for no combatant */
+	int32 Slot = INDEX_NONE;
+
+	/** Generation of the slot when the handle was made, so handles to removed combatants are recognized */
+	uint32 Generation = 0;
+
+	/** Whether the handle was ever given out; it may still refer to a removed combatant */
+	bool IsSet() const
+	{
+		return Slot != INDEX_NONE;
+	}
+
+	bool operator==(const FStrikesAttributeHandle& Other) const
+	{
+		return Slot == Other.Slot && Generation == Other.Generation;
+	}
+};
+
+/**
+ * Health and magic of many combatants, one array per field, so per-frame rules run as tight loops over
+ * contiguous values instead of per-actor calls.
+ *
+ * Combatants are kept packed: removing one moves the last one into its place, so the index of a combatant changes
+ * over time. Keep handles, and resolve them with GetIndex right before use.
+ */
+class STRIKESCORE_API FStrikesAttributeStore
+{
+public:
+	/**
+	 * Adds a combatant.
+	 *
+	 * @param Health Initial health.
+	 * @param Magic Initial magic.
+	 * @param Rules Magic tuning of the combatant; a curve it refers to must outlive the combatant.
+	 * @return Handle to the combatant.
+	 */
+	FStrikesAttributeHandle Add(const FStrikesHealthState& Health, const FStrikesMagicState& Magic,
+	                            const FStrikesMagicRules& Rules);
+
+	/** Removes a combatant; does nothing if the handle was already removed */
+	void Remove(FStrikesAttributeHandle Handle);
+
+	/** Number of combatants */
+	int32 Num() const
+	{
+		return DenseToSlot.Num();
+	}
+
+	/** Current index of a combatant, or INDEX_NONE if the handle was removed */
+	int32 GetIndex(FStrikesAttributeHandle Handle) const;
+
+	/** Handle of the combatant at an index */
+	FStrikesAttributeHandle GetHandle(int32 Index) const;
+
+	FStrikesHealthState GetHealth(int32 Index) const;
+	void SetHealth(int32 Index, const FStrikesHealthState& State);
+
+	FStrikesMagicState GetMagic(int32 Index) const;
+	void SetMagic(int32 Index, const FStrikesMagicState& State);
+
+	const FStrikesMagicRules& GetMagicRules(int32 Index) const
+	{
+		return MagicRules[Index];
+	}
+
+	void SetMagicRules(int32 Index, const FStrikesMagicRules& Rules)
+	{
+		MagicRules[Index] = Rules;
+	}
+
+	/** Whether the invincibility window after the last damage has passed */
+	bool IsDamageable(const int32 Index, const double Now) const
+	{
+		return Now >= InvincibleUntilTime[Index];
+	}
+
+	/** Health percentage of every combatant, by index */
+	TConstArrayView<float> GetHealthPercentages() const
+	{
+		return HealthPercentage;
+	}
+
+	/**
+	 * Applies magic transitions that came due: the start of regeneration, the end of the curve and the end of the
+	 * cooldown.
+	 *
+	 * @param Now Current time.
+	 * @param OutChanged Receives the index of every combatant whose state changed.
+	 */
+	void SettleMagic(double Now, TArray<int32>& OutChanged);
+
+	/**
+	 * Applies damage to every combatant, as StrikesHealth::TakeDamage does. Invincibility isn't checked, so the loop
+	 * stays branch-free; callers only give damage to combatants that pass IsDamageable.
+	 *
+	 * @param Damage Damage for each combatant, by index; combatants with no damage are skipped.
+	 * @param InvincibilityDuration Seconds a damaged combatant is invincible afterwards.
+	 * @param Now Current time.
+	 * @param OutDied Receives the index of every combatant that died.
+	 */
+	void TakeDamage(TConstArrayView<float> Damage, float InvincibilityDuration, double Now, TArray<int32>& OutDied);
+
+	/**
+	 * Gets the current magic percentage of every combatant.
+	 *
+	 * @param Now Current time.
+	 * @param OutPercentages Receives the percentage of each combatant, by index; as many entries as combatants.
+	 */
+	void GetMagicPercentages(double Now, TArrayView<float> OutPercentages) const;
+
+private:
+	/** Calls Function with every per-combatant array */
+	template <typename FunctionType>
+	void ForEachColumn(FunctionType&& Function)
+	{
+		Function(FullHealth);
+		Function(Health);
+		Function(HealthPercentage);
+		Function(PreviousHealth);
+		Function(InvincibleUntilTime);
+		Function(bRedFlash);
+		Function(Magic);
+		Function(MagicPercentage);
+		Function(PreviousMagic);
+		Function(MagicCurveDelta);
+		Function(MagicCurveStartTime);
+		Function(MagicUsableTime);
+		Function(MagicRegenTime);
+		Function(bMagicCurvePlaying);
+		Function(bMagicRegenPending);
+		Function(bMagicCoolingDown);
+		Function(MagicRules);
+		Function(DenseToSlot);
+	}
+
+	// Health, by index
+	TArray<float> FullHealth;
+	TArray<float> Health;
+	TArray<float> HealthPercentage;
+	TArray<float> PreviousHealth;
+	TArray<double> InvincibleUntilTime;
+	TArray<bool> bRedFlash;
+
+	// Magic, by index
+	TArray<float> Magic;
+	TArray<float> MagicPercentage;
+	TArray<float> PreviousMagic;
+	TArray<float> MagicCurveDelta;
+	TArray<double> MagicCurveStartTime;
+	TArray<double> MagicUsableTime;
+	TArray<double> MagicRegenTime;
+	TArray<bool> bMagicCurvePlaying;
+	TArray<bool> bMagicRegenPending;
+	TArray<bool> bMagicCoolingDown;
+	TArray<FStrikesMagicRules> MagicRules;
+
+	// Slot of each index, and index and generation of each slot
+	TArray<int32> DenseToSlot;
+	TArray<int32> SlotToDense;
+	TArray<uint32> SlotGeneration;
+
+	// Slots of removed combatants, reused by Add
+	TArray<int32> FreeSlots;
+};
@@ -0,0 +1,55 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Curve sampled at evenly spaced times from 0 to Length, so the rules can evaluate it without a UCurveFloat.
+ * Values in between samples are interpolated linearly.
+ */
+struct STRIKESCORE_API FStrikesCoreCurve
+{
+	/** Samples baked by default: one every 20ms for the 5 second magic curve */
+	static constexpr int32 DefaultNumSamples = 256;
+
+	/** Values at evenly spaced times, the first at 0 and the last at Length */
+	TArray<float> Samples;
+
+	/** Time of the last sample, in seconds */
+	float Length = 0.f;
+
+	/**
+	 * Replaces the samples with values of a function.
+	 *
+	 * @param InLength Time of the last sample, in seconds.
+	 * @param NumSamples Number of samples to take; at least 2.
+	 * @param Function Called with each sample time, returns the value at that time.
+	 */
+	template <typename FunctionType>
+	void Bake(const float InLength, const int32 NumSamples, FunctionType&& Function)
+	{
+		Length = FMath::Max(InLength, 0.f);
+		Samples.SetNumUninitialized(FMath::Max(NumSamples, 2));
+
+		const float Step = Length / (Samples.Num() - 1);
+		for (int32 Index = 0; Index < Samples.Num(); ++Index)
+		{
+			Samples[Index] = Function(Index * Step);
+		}
+	}
+
+	/** Whether the curve has been baked */
+	bool IsBaked() const
+	{
+		return Samples.Num() > 0;
+	}
+
+	/**
+	 * Gets the value at a time, holding the first and last value outside of [0, Length].
+	 *
+	 * @param Time Time in seconds.
+	 * @return Interpolated value, or 0 if the curve has not been baked.
+	 */
+	float Evaluate(float Time) const;
+};
@@ -0,0 +1,30 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace StrikesDamage
+{
+	/**
+	 * Counts the ticks of a repeating damage source that came due, catching up on every tick since the last call
+	 * like a looping timer would.
+	 *
+	 * @param NextDamageTime Time of the next tick; advanced past Now.
+	 * @param Interval Seconds between ticks.
+	 * @param Now Current time.
+	 * @return Number of ticks to apply.
+	 */
+	inline int32 ConsumeDueTicks(double& NextDamageTime, const float Interval, const double Now)
+	{
+		const float Step = FMath::Max(Interval, UE_KINDA_SMALL_NUMBER);
+
+		int32 NumTicks = 0;
+		while (NextDamageTime <= Now)
+		{
+			NextDamageTime += Step;
+			++NumTicks;
+		}
+		return NumTicks;
+	}
+}
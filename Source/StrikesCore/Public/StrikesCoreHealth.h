@@ -0,0 +1,118 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Health of one character, as FStrikesAttributeStore keeps it for AStrikesCharacter */
+struct FStrikesHealthState
+{
+	/** Total amount of health */
+	float FullHealth = 1000.f;
+
+	/** Current health */
+	float Health = 1000.f;
+
+	/** Current health compared to FullHealth */
+	float Percentage = 1.f;
+
+	/** Percentage before the last change */
+	float PreviousPercentage = 1.f;
+
+	/** Time until which damage is ignored */
+	double InvincibleUntilTime = 0.0;
+
+	/** Whether the screen should flash red for damage that hasn't been shown yet */
+	bool bRedFlash = false;
+};
+
+/** What a health change did, so the caller knows what to notify */
+enum class EStrikesHealthChange : uint8
+{
+	/** The percentage didn't change */
+	ENone,
+
+	/** The percentage changed */
+	EChanged,
+
+	/** The percentage changed and dropped to zero */
+	EDied
+};
+
+namespace StrikesHealth
+{
+	/** Health a character starts and resets with */
+	constexpr float DefaultFullHealth = 1000.f;
+
+	/** Health restored by a medkit */
+	constexpr float MedKitHeal = 100.f;
+
+	/** Puts the state back to full health with no invincibility or flash */
+	STRIKESCORE_API void Reset(FStrikesHealthState& State, float FullHealth = DefaultFullHealth);
+
+	/**
+	 * Adds to the health, clamped to [0, FullHealth].
+	 *
+	 * @param State Health to change.
+	 * @param Change Amount to add; negative for damage.
+	 * @return Whether the percentage changed, and whether this change took it down to zero.
+	 */
+	STRIKESCORE_API EStrikesHealthChange Apply(FStrikesHealthState& State, float Change);
+
+	/**
+	 * Applies damage: flashes red, removes the health and starts the invincibility window.
+	 * Damage during the invincibility window of the last hit is ignored.
+	 *
+	 * @param State Health to damage.
+	 * @param Damage Amount of health to remove.
+	 * @param InvincibilityDuration Seconds the character is invincible afterwards.
+	 * @param Now Current time.
+	 * @return Result of the health change.
+	 */
+	STRIKESCORE_API EStrikesHealthChange TakeDamage(FStrikesHealthState& State, float Damage,
+	                                                float InvincibilityDuration, double Now);
+
+	/**
+	 * Applies damage to many characters, skipping the ones that are invincible.
+	 *
+	 * @param States Health to damage.
+	 * @param Damage Damage for each state; states with no damage are skipped.
+	 * @param InvincibilityDuration Seconds a damaged character is invincible afterwards.
+	 * @param Now Current time.
+	 * @param OutDied Receives the index of every state that died.
+	 */
+	STRIKESCORE_API void TakeDamageAll(TArrayView<FStrikesHealthState> States, TConstArrayView<float> Damage,
+	                                   float InvincibilityDuration, double Now, TArray<int32>& OutDied);
+
+	/** Whether the invincibility window after the last damage has passed */
+	inline bool IsDamageable(const FStrikesHealthState& State, const double Now)
+	{
+		return Now >= State.InvincibleUntilTime;
+	}
+
+	/** Starts an invincibility window of Duration seconds */
+	inline void StartInvincibility(FStrikesHealthState& State, const float Duration, const double Now)
+	{
+		State.InvincibleUntilTime = Now + Duration;
+	}
+
+	/** Ends the invincibility window early */
+	inline void EndInvincibility(FStrikesHealthState& State)
+	{
+		State.InvincibleUntilTime = 0.0;
+	}
+
+	/** Whether a medkit would heal the character */
+	inline bool CanBeHealed(const FStrikesHealthState& State)
+	{
+		return State.Percentage < 1.f;
+	}
+
+	/** Clears the red flash, returning whether it was set */
+	inline bool ConsumeFlash(FStrikesHealthState& State)
+	{
+		const bool bFlash = State.bRedFlash;
+		State.bRedFlash = false;
+		return bFlash;
+	}
+}
@@ -0,0 +1,186 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FStrikesCoreCurve;
+
+/**
+ * Magic of one character, as FStrikesAttributeStore keeps it for AStrikesCharacter.
+ * Changes play the magic curve from PreviousPercentage towards PreviousPercentage + CurveDelta; the curve is
+ * evaluated on read, so nothing needs to step the state while it plays.
+ */
+struct FStrikesMagicState
+{
+	/** Current amount of magic, up to FStrikesMagicRules::FullMagic */
+	float Magic = 100.f;
+
+	/** Percentage the curve was last settled at */
+	float Percentage = 1.f;
+
+	/** Percentage the playing curve started from */
+	float PreviousPercentage = 1.f;
+
+	/** Change in percentage scaled by the playing curve */
+	float CurveDelta = 0.f;
+
+	/** Time the curve started playing */
+	double CurveStartTime = 0.0;
+
+	/** Time the cooldown after the last change ends; the weapon shows overheat until then */
+	double UsableTime = 0.0;
+
+	/** Time at which magic starts regenerating */
+	double RegenTime = 0.0;
+
+	/** Whether the curve is playing */
+	bool bCurvePlaying = false;
+
+	/** Whether regeneration is scheduled at RegenTime */
+	bool bRegenPending = false;
+
+	/** Whether the cooldown until UsableTime has not been settled yet, so its end is reported once */
+	bool bCoolingDown = false;
+};
+
+/** Tuning shared by every character the magic rules run for */
+struct FStrikesMagicRules
+{
+	/** Total amount of magic */
+	float FullMagic = 100.f;
+
+	/**
+	 * Amount of magic a curve value of 1 stands for. The character has always passed its FullHealth here,
+	 * which the HUD and the weapon threshold are tuned around.
+	 */
+	float AmountScale = 1000.f;
+
+	/** How long the curve plays after each change, in seconds */
+	float CurveLength = 5.f;
+
+	/** Delay after spending magic before it starts regenerating, in seconds */
+	float RegenDelay = 5.f;
+
+	/** Magic spent by a shot */
+	float SpendPerShot = 20.f;
+
+	/** Curve played after each change; without one, changes apply at once */
+	const FStrikesCoreCurve* Curve = nullptr;
+};
+
+namespace StrikesMagic
+{
+	/** Puts the state back to full magic with no cooldown, curve or regeneration */
+	STRIKESCORE_API void Reset(FStrikesMagicState& State, const FStrikesMagicRules& Rules);
+
+	/**
+	 * Samples the curve.
+	 *
+	 * @param Rules Rules with the curve.
+	 * @param From Percentage at the start of the curve.
+	 * @param Delta Change in percentage scaled by the curve.
+	 * @param StartTime Time the curve started.
+	 * @param Time Time to sample at.
+	 * @return Unclamped percentage.
+	 */
+	STRIKESCORE_API float SampleCurve(const FStrikesMagicRules& Rules, float From, float Delta, double StartTime,
+	                                  double Time);
+
+	/**
+	 * Evaluates the curve at a time, including regeneration that has started but not been settled yet.
+	 *
+	 * @return Unclamped percentage.
+	 */
+	STRIKESCORE_API float Evaluate(const FStrikesMagicState& State, const FStrikesMagicRules& Rules, double Now);
+
+	/** Whether the percentage is currently driven by the curve rather than by Percentage */
+	STRIKESCORE_API bool IsCurveDriven(const FStrikesMagicState& State, const FStrikesMagicRules& Rules, double Now);
+
+	/** Whether the percentage changes over time right now, because the curve or regeneration is playing */
+	STRIKESCORE_API bool IsAnimating(const FStrikesMagicState& State, const FStrikesMagicRules& Rules, double Now);
+
+	/** Gets the current percentage, in [0, 1] */
+	STRIKESCORE_API float GetPercentage(const FStrikesMagicState& State, const FStrikesMagicRules& Rules, double Now);
+
+	/** Gets the current amount of magic, in [0, FullMagic] */
+	STRIKESCORE_API float GetAmount(const FStrikesMagicState& State, const FStrikesMagicRules& Rules, double Now);
+
+	/** Whether the cooldown after the last change has passed. Shots don't wait for it; the weapon's fire rate paces them */
+	inline bool CanUse(const FStrikesMagicState& State, const double Now)
+	{
+		return Now >= State.UsableTime;
+	}
+
+	/**
+	 * Whether a shot can be fired: there is magic left once the spends the curve is still animating are taken off.
+	 * Independent of the cooldown, so a weapon can fire at its own rate.
+	 */
+	STRIKESCORE_API bool CanFire(const FStrikesMagicState& State, const FStrikesMagicRules& Rules, double Now);
+
+	/** Stores the value the curve has reached in Magic and Percentage */
+	STRIKESCORE_API void StoreCurveValue(FStrikesMagicState& State, const FStrikesMagicRules& Rules, double Now);
+
+	/**
+	 * Applies transitions whose time has passed: the start of regeneration, the end of the curve and the end of the
+	 * cooldown.
+	 *
+	 * @return Whether the state changed.
+	 */
+	STRIKESCORE_API bool Settle(FStrikesMagicState& State, const FStrikesMagicRules& Rules, double Now);
+
+	/**
+	 * Starts playing the curve from the beginning.
+	 *
+	 * @return Whether a curve started; false if the rules have none.
+	 */
+	STRIKESCORE_API bool PlayCurve(FStrikesMagicState& State, const FStrikesMagicRules& Rules, double Now);
+
+	/**
+	 * Settles the state, then stops the curve, keeping the value reached so far.
+	 *
+	 * @return Whether the state changed.
+	 */
+	STRIKESCORE_API bool StopCurve(FStrikesMagicState& State, const FStrikesMagicRules& Rules, double Now);
+
+	/**
+	 * Animates the percentage towards the current Magic, as after regeneration.
+	 *
+	 * @return Whether a curve started.
+	 */
+	STRIKESCORE_API bool Update(FStrikesMagicState& State, const FStrikesMagicRules& Rules, double Now);
+
+	/**
+	 * Animates a change of magic and starts the cooldown, which lasts as long as the curve.
+	 * A spend the interrupted curve hadn't shown yet is carried into the new one, so quick changes add up.
+	 *
+	 * @param Amount Amount of magic to add; negative to spend.
+	 * @return Whether a curve started.
+	 */
+	STRIKESCORE_API bool Change(FStrikesMagicState& State, const FStrikesMagicRules& Rules, float Amount, double Now);
+
+	/**
+	 * Spends the magic of a shot and schedules regeneration after RegenDelay.
+	 *
+	 * @return Whether a curve started.
+	 */
+	STRIKESCORE_API bool Spend(FStrikesMagicState& State, const FStrikesMagicRules& Rules, double Now);
+
+	/** Settles the state, ends the cooldown and clears the change */
+	STRIKESCORE_API void ResetCooldown(FStrikesMagicState& State, const FStrikesMagicRules& Rules, double Now);
+
+	/**
+	 * Settles many states.
+	 *
+	 * @return Number of states that changed.
+	 */
+	STRIKESCORE_API int32 SettleAll(TArrayView<FStrikesMagicState> States, const FStrikesMagicRules& Rules, double Now);
+
+	/**
+	 * Gets the current percentage of many states.
+	 *
+	 * @param OutPercentages Receives the percentage of each state; as many entries as States.
+	 */
+	STRIKESCORE_API void GetPercentageAll(TConstArrayView<FStrikesMagicState> States, const FStrikesMagicRules& Rules,
+	                                      double Now, TArrayView<float> OutPercentages);
+}
@@ -0,0 +1,14 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class StrikesCore : ModuleRules
+{
+	public StrikesCore(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		// Gameplay rules only: no UObjects, so programs can link them without booting the engine
+		PublicDependencyModuleNames.AddRange(new string[] { "Core" });
+	}
+}
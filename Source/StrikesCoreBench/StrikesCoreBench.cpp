@@ -0,0 +1,309 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "RequiredProgramMainCPPInclude.h"
+#include "StrikesCoreAttributes.h"
+#include "StrikesCoreCurve.h"
+#include "Math/RandomStream.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogStrikesCoreBench, Log, All);
+
+IMPLEMENT_APPLICATION(StrikesCoreBench, "StrikesCoreBench");
+
+namespace
+{
+	/** Simulated frame rate; only decides how far the rules' clock moves per frame */
+	constexpr double FrameSeconds = 1.0 / 60.0;
+
+	/**
+	 * Health and magic of many characters stepped the way the game steps them: some take damage, some fire, and
+	 * every frame magic is settled and read for the HUD. The layouts below share the schedule and tuning.
+	 */
+	struct FStrikesCoreBenchBase
+	{
+		FStrikesMagicRules MagicRules;
+		FStrikesCoreCurve MagicCurve;
+		float InvincibilityDuration = 2.f;
+		float DamagePerHit = 50.f;
+
+		/** Frames between hits and shots of each entity, and the frame offset they start at */
+		TArray<int32> HitPeriod;
+		TArray<int32> ShotPeriod;
+		TArray<int32> Phase;
+
+		/** Per-frame scratch */
+		TArray<float> Damage;
+		TArray<float> Percentages;
+		TArray<int32> Died;
+
+		/** Sum of everything read, so the work can't be optimized away */
+		double Checksum = 0.0;
+		int64 NumDeaths = 0;
+		int64 NumShots = 0;
+
+		void InitSchedule(const int32 NumEntities, const int32 Seed)
+		{
+			// Same shape as the character's default magic curve
+			MagicCurve.Bake(MagicRules.CurveLength, FStrikesCoreCurve::DefaultNumSamples, [this](const float Time)
+			{
+				return FMath::SmoothStep(0.f, MagicRules.CurveLength, Time);
+			});
+			MagicRules.Curve = &MagicCurve;
+			MagicRules.AmountScale = StrikesHealth::DefaultFullHealth;
+
+			HitPeriod.SetNumUninitialized(NumEntities);
+			ShotPeriod.SetNumUninitialized(NumEntities);
+			Phase.SetNumUninitialized(NumEntities);
+			Damage.SetNumZeroed(NumEntities);
+			Percentages.SetNumZeroed(NumEntities);
+
+			FRandomStream Random(Seed);
+			for (int32 Index = 0; Index < NumEntities; ++Index)
+			{
+				// Between one hit per second and one every ten, shots a bit more often
+				HitPeriod[Index] = Random.RandRange(60, 600);
+				ShotPeriod[Index] = Random.RandRange(30, 300);
+				Phase[Index] = Random.RandRange(0, 599);
+			}
+		}
+
+		bool IsHitDue(const int32 Index, const int32 Frame) const
+		{
+			return (Frame + Phase[Index]) % HitPeriod[Index] == 0;
+		}
+
+		bool IsShotDue(const int32 Index, const int32 Frame) const
+		{
+			return (Frame + Phase[Index]) % ShotPeriod[Index] == 0;
+		}
+	};
+
+	/** One FStrikesHealthState and FStrikesMagicState per entity */
+	struct FStrikesCoreBench : FStrikesCoreBenchBase
+	{
+		TArray<FStrikesHealthState> Health;
+		TArray<FStrikesMagicState> Magic;
+
+		void Init(const int32 NumEntities, const int32 Seed)
+		{
+			InitSchedule(NumEntities, Seed);
+
+			Health.SetNum(NumEntities);
+			Magic.SetNum(NumEntities);
+			for (int32 Index = 0; Index < NumEntities; ++Index)
+			{
+				StrikesHealth::Reset(Health[Index]);
+				StrikesMagic::Reset(Magic[Index], MagicRules);
+			}
+		}
+
+		void Step(const int32 Frame)
+		{
+			const double Now = Frame * FrameSeconds;
+			const int32 NumEntities = Health.Num();
+
+			// Damage sources respect the invincibility window, as the game's do
+			for (int32 Index = 0; Index < NumEntities; ++Index)
+			{
+				const bool bHit = IsHitDue(Index, Frame) && StrikesHealth::IsDamageable(Health[Index], Now);
+				Damage[Index] = bHit ? DamagePerHit : 0.f;
+			}
+
+			Died.Reset();
+			StrikesHealth::TakeDamageAll(Health, Damage, InvincibilityDuration, Now, Died);
+
+			// Keep the population constant, as bots respawn
+			for (const int32 Index : Died)
+			{
+				StrikesHealth::Reset(Health[Index]);
+				StrikesMagic::Reset(Magic[Index], MagicRules);
+			}
+			NumDeaths += Died.Num();
+
+			StrikesMagic::SettleAll(Magic, MagicRules, Now);
+
+			for (int32 Index = 0; Index < NumEntities; ++Index)
+			{
+				if (IsShotDue(Index, Frame) && StrikesMagic::CanFire(Magic[Index], MagicRules, Now))
+				{
+					StrikesMagic::Spend(Magic[Index], MagicRules, Now);
+					++NumShots;
+				}
+			}
+
+			// What the HUD reads every frame
+			StrikesMagic::GetPercentageAll(Magic, MagicRules, Now, Percentages);
+			for (int32 Index = 0; Index < NumEntities; ++Index)
+			{
+				Checksum += Percentages[Index] + Health[Index].Percentage;
+			}
+		}
+	};
+
+	/** Every entity in one FStrikesAttributeStore, as UStrikesAttributeSubsystem keeps characters */
+	struct FStrikesCoreStoreBench : FStrikesCoreBenchBase
+	{
+		FStrikesAttributeStore Store;
+
+		void Init(const int32 NumEntities, const int32 Seed)
+		{
+			InitSchedule(NumEntities, Seed);
+
+			FStrikesHealthState Health;
+			StrikesHealth::Reset(Health);
+			FStrikesMagicState Magic;
+			StrikesMagic::Reset(Magic, MagicRules);
+			for (int32 Index = 0; Index < NumEntities; ++Index)
+			{
+				Store.Add(Health, Magic, MagicRules);
+			}
+		}
+
+		void Step(const int32 Frame)
+		{
+			const double Now = Frame * FrameSeconds;
+			const int32 NumEntities = Store.Num();
+
+			for (int32 Index = 0; Index < NumEntities; ++Index)
+			{
+				const bool bHit = IsHitDue(Index, Frame) && Store.IsDamageable(Index, Now);
+				Damage[Index] = bHit ? DamagePerHit : 0.f;
+			}
+
+			Died.Reset();
+			Store.TakeDamage(Damage, InvincibilityDuration, Now, Died);
+
+			for (const int32 Index : Died)
+			{
+				FStrikesHealthState Health;
+				StrikesHealth::Reset(Health);
+				Store.SetHealth(Index, Health);
+
+				FStrikesMagicState Magic;
+				StrikesMagic::Reset(Magic, MagicRules);
+				Store.SetMagic(Index, Magic);
+			}
+			NumDeaths += Died.Num();
+
+			// The changed indices are what the subsystem would replicate
+			Died.Reset();
+			Store.SettleMagic(Now, Died);
+
+			for (int32 Index = 0; Index < NumEntities; ++Index)
+			{
+				if (!IsShotDue(Index, Frame))
+				{
+					continue;
+				}
+
+				FStrikesMagicState Magic = Store.GetMagic(Index);
+				if (StrikesMagic::CanFire(Magic, MagicRules, Now))
+				{
+					StrikesMagic::Spend(Magic, MagicRules, Now);
+					Store.SetMagic(Index, Magic);
+					++NumShots;
+				}
+			}
+
+			Store.GetMagicPercentages(Now, Percentages);
+			const TConstArrayView<float> HealthPercentages = Store.GetHealthPercentages();
+			for (int32 Index = 0; Index < NumEntities; ++Index)
+			{
+				Checksum += Percentages[Index] + HealthPercentages[Index];
+			}
+		}
+	};
+
+	/**
+	 * Warms up and measures one layout, then logs its time per frame.
+	 *
+	 * @return Average milliseconds per frame.
+	 */
+	template <typename BenchType>
+	double RunBench(const TCHAR* Name, const int32 NumEntities, const int32 NumFrames, const int32 NumWarmupFrames,
+	                const int32 Seed)
+	{
+		BenchType Bench;
+		Bench.Init(NumEntities, Seed);
+
+		for (int32 Frame = 0; Frame < NumWarmupFrames; ++Frame)
+		{
+			Bench.Step(Frame);
+		}
+
+		TArray<double> FrameMs;
+		FrameMs.Reserve(NumFrames);
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Bench.Step(NumWarmupFrames + Frame);
+			FrameMs.Add((FPlatformTime::Seconds() - StartTime) * 1000.0);
+		}
+
+		double TotalMs = 0.0;
+		for (const double Ms : FrameMs)
+		{
+			TotalMs += Ms;
+		}
+		const double AvgMs = TotalMs / NumFrames;
+
+		FrameMs.Sort();
+		const double MinMs = FrameMs[0];
+		const double P95Ms = FrameMs[FMath::Min(FMath::FloorToInt32(NumFrames * 0.95), NumFrames - 1)];
+
+		UE_LOG(LogStrikesCoreBench, Display,
+		       TEXT("%s: %d entities, %d frames: avg %.3f ms, min %.3f ms, p95 %.3f ms per frame"),
+		       Name, NumEntities, NumFrames, AvgMs, MinMs, P95Ms);
+		UE_LOG(LogStrikesCoreBench, Display,
+		       TEXT("%s: %.1f ns per entity per frame; %lld shots, %lld deaths, checksum %.3f"),
+		       Name, AvgMs * 1.0e6 / NumEntities, Bench.NumShots, Bench.NumDeaths, Bench.Checksum);
+
+		return AvgMs;
+	}
+}
+
+/**
+ * Steps the health and magic rules of StrikesCore for many entities and reports the time per frame, without the
+ * engine or any UObject: once with a value type per entity, once with the entities in an FStrikesAttributeStore.
+ * Options: -Entities=100000 -Frames=600 -Warmup=60 -Seed=0 -Layout=Both|States|Store
+ */
+INT32_MAIN_INT32_ARGC_TCHAR_ARGV()
+{
+	FTaskTagScope Scope(ETaskTag::EGameThread);
+	ON_SCOPE_EXIT
+	{
+		RequestEngineExit(TEXT("StrikesCoreBench exiting"));
+		FEngineLoop::AppPreExit();
+		FModuleManager::Get().UnloadModulesAtShutdown();
+		FEngineLoop::AppExit();
+	};
+
+	if (const int32 Result = GEngineLoop.PreInit(ArgC, ArgV))
+	{
+		return Result;
+	}
+
+	int32 NumEntities = 100000;
+	int32 NumFrames = 600;
+	int32 NumWarmupFrames = 60;
+	int32 Seed = 0;
+	FParse::Value(FCommandLine::Get(), TEXT("Entities="), NumEntities);
+	FParse::Value(FCommandLine::Get(), TEXT("Frames="), NumFrames);
+	FParse::Value(FCommandLine::Get(), TEXT("Warmup="), NumWarmupFrames);
+	FParse::Value(FCommandLine::Get(), TEXT("Seed="), Seed);
+	NumEntities = FMath::Max(NumEntities, 1);
+	NumFrames = FMath::Max(NumFrames, 1);
+
+	// Both layouts run the same schedule, so their shots, deaths and checksums match
+	FString Layout = TEXT("Both");
+	FParse::Value(FCommandLine::Get(), TEXT("Layout="), Layout);
+	if (Layout != TEXT("Store"))
+	{
+		RunBench<FStrikesCoreBench>(TEXT("States"), NumEntities, NumFrames, NumWarmupFrames, Seed);
+	}
+	if (Layout != TEXT("States"))
+	{
+		RunBench<FStrikesCoreStoreBench>(TEXT("Store"), NumEntities, NumFrames, NumWarmupFrames, Seed);
+	}
+
+	return 0;
+}